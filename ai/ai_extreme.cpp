@@ -11,11 +11,15 @@
  */
 
 #include "ai_extreme.h"
+#include "search_core.h"
 
 #include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <limits>
+#include <sstream>
 
 namespace fs = std::filesystem;
 
@@ -24,23 +28,45 @@ namespace fs = std::filesystem;
 // ============================================================================
 
 #define MAX_SEARCH_DEPTH 12
-#define TIME_LIMIT_MS 15000
 #define ENDGAME_DEPTH 16
 #define ENDGAME_THRESHOLD 12
 
+// Minimum remaining depth for Enhanced Transposition Cutoffs (child TT probes)
+#define ETC_MIN_DEPTH 3
+
+// Shallow-search move ordering defaults (tunable at runtime)
+#define SHALLOW_ORDER_MIN_DEPTH 7  // Remaining depth needed to order by shallow search
+#define SHALLOW_ORDER_DEPTH 1      // Depth of the per-child ordering search
+
+// Stability cutoff in solved subtrees (tunable at runtime, 0 = off)
+#define STABILITY_CUTOFF_MIN_EMPTIES 2
+
+// Move ordering heuristics
+#define MAX_PLY 64
+#define HISTORY_PHASES 4      // Game phases for history table (16 empties each)
+#define HISTORY_LIMIT 2000    // Table is halved when an entry exceeds this
+#define KILLER_BONUS_1 8000   // Primary killer (just below corners)
+#define KILLER_BONUS_2 7000   // Secondary killer
+#define HASH_MOVE_SCORE (1 << 30)
+#define PARITY_ORDER_MAX_EMPTIES 14  // Endgame: prefer moves in odd quadrants
+#define PARITY_BONUS 1000
+#define MAX_MOVES 64          // Upper bound on legal moves per position
+
 // L�mite de nodos por defecto - ahora configurable en runtime
-static const int DEFAULT_MAX_NODES = 500000;
+static const uint64_t DEFAULT_MAX_NODES = 500000;
 
 // Book year limit to stop looking for in the database folder
 #define BOOK_LIMIT_YEAR 1977
 
 #define INFINITY_SCORE 1000000
-#define WIN_SCORE 100000
-#define LOSE_SCORE -100000
+
+// Finished games score their disc margin times this (the hand-crafted
+// parity weight; the learned evaluations use PATTERN_SCORE_PER_DISC)
+#define FINAL_SCORE_PER_DISC 10
 
 // Note: CORNERS, EDGES, X_SQUARES already defined in model.h
 
-// Evaluation function weights
+// Evaluation function weights (defaults of the per-stage table)
 #define WEIGHT_MOBILITY 10
 #define WEIGHT_CORNER 100
 #define WEIGHT_X_SQUARE -50
@@ -49,52 +75,152 @@ static const int DEFAULT_MAX_NODES = 500000;
 #define WEIGHT_STABILITY 15
 #define WEIGHT_FRONTIER -5
 
+// Evaluation used by the search (chosen when each search starts)
+enum EvalSource {
+    EVAL_SOURCE_HANDCRAFTED,  // AIExtreme::Evaluator
+    EVAL_SOURCE_PATTERNS,     // PatternEvaluator, when weights are loaded
+    EVAL_SOURCE_NEURAL        // NeuralEvaluator, when loaded and enabled
+};
+
+// Per-stage evaluation weights
+#define EVAL_STAGE_FILE "eval_stages.txt"  // Optional, looked up next to the WTH files
+#define EVAL_STAGES 61                     // One weight row per empty-square count
+
+/**
+ * @brief Terms of the hand-crafted evaluation (columns of the stage table)
+ */
+enum EvalTerm {
+    EVAL_MOBILITY,
+    EVAL_CORNERS,
+    EVAL_POSITIONAL,
+    EVAL_STABILITY,
+    EVAL_FRONTIER,
+    EVAL_PARITY,
+    EVAL_TERM_COUNT
+};
+
 // ============================================================================
 // Evaluator Implementation
 // ============================================================================
 
 /**
  * @brief Advanced board evaluation with multiple heuristics
+ *
+ * Every term is weighted by the row of the stage table for the current
+ * number of empty squares, so the blend changes smoothly over the game
+ * without branching on thresholds.
  */
 class AIExtreme::Evaluator {
 public:
     static const int pieceSquareTable[64];
 
+    Evaluator() {
+        setDefaultStageWeights();
+    }
+
     int evaluate(const Board_t& board, PlayerColor_t player) {
-        int emptyCount = getEmptyCount(board);
+        const int16_t* weights = stageWeights[getEmptyCount(board)];
+
+        return weights[EVAL_MOBILITY] * evaluateMobility(board, player) +
+            weights[EVAL_CORNERS] * evaluateCorners(board, player) +
+            weights[EVAL_POSITIONAL] * evaluatePositional(board, player) +
+            weights[EVAL_STABILITY] * evaluateStability(board, player) +
+            weights[EVAL_FRONTIER] * evaluateFrontier(board, player) +
+            weights[EVAL_PARITY] * evaluateDiscParity(board, player);
+    }
 
-        // In endgame, disc count matters most
-        if (emptyCount <= 10) {
-            return evaluateDiscParity(board, player) * 10;
+    /**
+     * @brief Built-in table, equivalent to the former fixed thresholds
+     */
+    void setDefaultStageWeights() {
+        for (int empties = 0; empties < EVAL_STAGES; empties++) {
+            int16_t* weights = stageWeights[empties];
+
+            // With 10 empties or fewer only the disc count matters
+            bool endgame = empties <= 10;
+
+            weights[EVAL_MOBILITY] = endgame ? 0 : WEIGHT_MOBILITY;
+            weights[EVAL_CORNERS] = endgame ? 0 : WEIGHT_CORNER;
+            weights[EVAL_POSITIONAL] = endgame ? 0 : 1;
+            weights[EVAL_STABILITY] = (!endgame && empties < 30) ? WEIGHT_STABILITY : 0;
+            weights[EVAL_FRONTIER] = (!endgame && empties > 20) ? WEIGHT_FRONTIER : 0;
+            weights[EVAL_PARITY] = endgame ? 10 : (empties < 20 ? 30 - empties : 0);
         }
+    }
 
-        int score = 0;
-
-        // Mobility - very important in midgame
-        score += evaluateMobility(board, player) * WEIGHT_MOBILITY;
-
-        // Corner control - always important
-        score += evaluateCorners(board, player) * WEIGHT_CORNER;
+    /**
+     * @brief Replaces the stage table with weights read from a text file
+     *
+     * Each non-comment line is a knot: an empty-square count followed by
+     * one weight per term (mobility, corners, positional, stability,
+     * frontier, parity). Knots must be in increasing order; rows between
+     * two knots are interpolated linearly and rows outside the listed
+     * range take the nearest knot. On error the current table is kept.
+     *
+     * @return True if the file was read
+     */
+    bool loadStageWeights(const std::string& filename) {
+        std::ifstream file(filename);
+        if (!file) {
+            return false;
+        }
 
-        // Positional evaluation
-        score += evaluatePositional(board, player);
+        struct StageKnot {
+            int empties;
+            int weights[EVAL_TERM_COUNT];
+        };
+        std::vector<StageKnot> knots;
+
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(file, line)) {
+            lineNumber++;
+            line = line.substr(0, line.find('#'));
+
+            std::istringstream fields(line);
+            StageKnot knot;
+            if (!(fields >> knot.empties))
+                continue;
+
+            bool valid = knot.empties >= 0 && knot.empties < EVAL_STAGES &&
+                (knots.empty() || knot.empties > knots.back().empties);
+            for (int term = 0; term < EVAL_TERM_COUNT; term++) {
+                valid = valid && (fields >> knot.weights[term]);
+            }
 
-        // Stability - more important in late-midgame
-        if (emptyCount < 30) {
-            score += evaluateStability(board, player) * WEIGHT_STABILITY;
+            if (!valid) {
+                std::cerr << "Invalid stage weights at " << filename << ":" << lineNumber
+                          << std::endl;
+                return false;
+            }
+            knots.push_back(knot);
         }
 
-        // Frontier discs - important in opening/midgame
-        if (emptyCount > 20) {
-            score += evaluateFrontier(board, player) * WEIGHT_FRONTIER;
+        if (knots.empty()) {
+            return false;
         }
 
-        // Disc parity - increasingly important as game progresses
-        if (emptyCount < 20) {
-            score += evaluateDiscParity(board, player) * (30 - emptyCount);
+        size_t k = 0;
+        for (int empties = 0; empties < EVAL_STAGES; empties++) {
+            while (k + 1 < knots.size() && knots[k + 1].empties <= empties) {
+                k++;
+            }
+            const StageKnot& low = knots[k];
+            const StageKnot& high = (k + 1 < knots.size()) ? knots[k + 1] : low;
+
+            for (int term = 0; term < EVAL_TERM_COUNT; term++) {
+                int weight = low.weights[term];
+                if (empties > low.empties && high.empties > low.empties) {
+                    weight += (high.weights[term] - low.weights[term]) *
+                        (empties - low.empties) / (high.empties - low.empties);
+                }
+                stageWeights[empties][term] = (int16_t)std::clamp(weight,
+                    (int)std::numeric_limits<int16_t>::min(),
+                    (int)std::numeric_limits<int16_t>::max());
+            }
         }
 
-        return score;
+        return true;
     }
 
     int evaluateMobility(const Board_t& board, PlayerColor_t player) {
@@ -132,19 +258,12 @@ public:
     }
 
     int evaluateStability(const Board_t& board, PlayerColor_t player) {
-        int stableScore = 0;
         uint64_t myPieces = getPlayerBitboard(board, player);
         uint64_t oppPieces = getOpponentBitboard(board, player);
 
-        // Corners are always stable
-        stableScore += countBits(myPieces & CORNERS) * 5;
-        stableScore -= countBits(oppPieces & CORNERS) * 5;
-
-        // Edges are semi-stable
-        stableScore += countBits(myPieces & EDGES);
-        stableScore -= countBits(oppPieces & EDGES);
-
-        return stableScore;
+        // Discs that can never be flipped again
+        return countBits(getStableDiscs(myPieces, oppPieces)) -
+            countBits(getStableDiscs(oppPieces, myPieces));
     }
 
     int evaluateFrontier(const Board_t& board, PlayerColor_t player) {
@@ -171,6 +290,9 @@ public:
     int evaluateDiscParity(const Board_t& board, PlayerColor_t player) {
         return getScoreDiff(board, player);
     }
+
+private:
+    int16_t stageWeights[EVAL_STAGES][EVAL_TERM_COUNT];  // [empty squares][term]
 };
 
 // Piece-square table
@@ -191,149 +313,684 @@ const int AIExtreme::Evaluator::pieceSquareTable[64] = {
 class AIExtreme::SearchEngine {
 public:
     TranspositionTable tt;  // Make public so OpeningBook can share it
+    TranspositionTable endgameTable;  // Solved positions, depth = empty squares
+    TimeManager timeManager;
 
     SearchEngine();
-    Move_t search(Board_t& board, PlayerColor_t player, double timeLimitSeconds);
+    Move_t search(Board_t& board, PlayerColor_t player);
+    void searchMultiPV(Board_t& board,
+        PlayerColor_t player,
+        int lineCount,
+        std::vector<AnalysisLine>& lines);
+
+    void getStats(SearchStats& stats) const;
 
-    int getNodesSearched() const {
-        return nodesSearched;
-    }
     int getMaxDepth() const {
         return maxDepthReached;
     }
 
-    void setMaxNodes(int limit) {
+    /**
+     * @brief Time into the last search at which an iteration completed
+     * @return Seconds, or -1 if the last search did not complete that depth
+     */
+    double getDepthSeconds(int depth) const {
+        return (depth > 0 && depth <= maxDepthReached) ? depthSeconds[depth] : -1.0;
+    }
+
+    /**
+     * @brief Adds the last search's iteration times to the cold averages
+     *
+     * Call after searches that did not start from a pondered tree.
+     */
+    void recordColdSearch() {
+        for (int depth = 1; depth <= maxDepthReached; depth++) {
+            coldDepthSeconds[depth] += depthSeconds[depth];
+            coldDepthSamples[depth]++;
+        }
+    }
+
+    /**
+     * @brief Average time cold searches took to complete a depth
+     * @return Seconds, or -1 if no cold search has completed it
+     */
+    double getColdDepthSeconds(int depth) const {
+        if (depth <= 0 || depth >= MAX_PLY || coldDepthSamples[depth] == 0)
+            return -1.0;
+        return coldDepthSeconds[depth] / coldDepthSamples[depth];
+    }
+
+    void setMaxNodes(uint64_t limit) {
         maxNodesLimit = (limit > 0) ? limit : DEFAULT_MAX_NODES;
     }
 
-    int getMaxNodes() const {
+    uint64_t getMaxNodes() const {
         return maxNodesLimit;
     }
 
+    void setStopFlag(const std::atomic<bool>* flag) {
+        stopFlag = flag;
+    }
+
+    void setProgressSink(SearchProgressBuffer* sink) {
+        progressSink = sink;
+    }
+
+    void setPondering(bool enabled) {
+        pondering = enabled;
+    }
+
+    /**
+     * @brief Principal variation of the last search (MOVE_PASS marks a pass)
+     */
+    void getPV(MoveList& pv) const {
+        pv.assign(bestPv, bestPv + bestPvLength);
+    }
+
+    void setShallowOrdering(int minDepth, int shallowDepth) {
+        shallowOrderMinDepth = minDepth;
+        shallowOrderDepth = (shallowDepth >= 0) ? shallowDepth : SHALLOW_ORDER_DEPTH;
+    }
+
+    void setStabilityCutoff(int minEmpties) {
+        stabilityCutoffMinEmpties = (minEmpties >= 0) ? minEmpties : STABILITY_CUTOFF_MIN_EMPTIES;
+    }
+
+    void setMtdf(bool enabled) {
+        useMtdf = enabled;
+    }
+
+    void setTableReplacement(TTReplacement policy) {
+        tt.setReplacement(policy);
+        endgameTable.setReplacement(policy);
+    }
+
+    bool loadPatternWeights(const std::string& filename) {
+        evalCache.clear();
+        return patternEval.load(filename);
+    }
+
+    bool loadStageWeights(const std::string& filename) {
+        evalCache.clear();
+        return evaluator.loadStageWeights(filename);
+    }
+
+    bool loadNeuralWeights(const std::string& filename) {
+        evalCache.clear();
+        return neuralEval.load(filename);
+    }
+
+    bool setNeuralEvaluation(bool enabled) {
+        useNeuralEval = enabled;
+        return enabled && neuralEval.isLoaded();
+    }
+
 private:
     Evaluator evaluator;
 
-    int nodesSearched;
-    int cutoffs;
-    int maxDepthReached;
-    Move_t pvMove;
+    // Pattern evaluation replaces the hand-crafted one once weights are
+    // loaded; its indices follow every move made by the search
+    PatternEvaluator patternEval;
+    PatternState patternState;
+
+    // Optional neural evaluation; its accumulator is updated the same way
+    NeuralEvaluator neuralEval;
+    NeuralAccumulator neuralAccumulator;
+    bool useNeuralEval;
 
-    int maxNodesLimit;
+    EvalSource evalSource;
 
-    std::chrono::time_point<std::chrono::high_resolution_clock> searchStartTime;
-    double timeLimit;
+    // Leaf scores of the current evaluation source, kept across searches
+    EvalCache evalCache;
+
+    uint64_t etcCutoffs;
+    uint64_t shallowOrderings;
+    uint64_t stabilityCutoffs;
+    uint64_t evalCalls;
+    int mtdfPasses;
+    int maxDepthReached;
+    double searchSeconds; // Duration of the last search
+
+    // Time into the last search at which each depth completed
+    double depthSeconds[MAX_PLY];
+
+    // Iteration times summed over cold searches (see recordColdSearch)
+    double coldDepthSeconds[MAX_PLY];
+    int coldDepthSamples[MAX_PLY];
+
+    // Table probes and hits (TT + endgame table) before the current search
+    uint64_t tableProbesAtStart;
+    uint64_t tableHitsAtStart;
+    int rootScore;  // Score of the last completed root search
+
+    // Triangular PV table: row ply holds the best line found from that ply,
+    // in columns ply .. pvLength[ply] - 1
+    Move_t pvTable[MAX_PLY][MAX_PLY];
+    int pvLength[MAX_PLY];
+
+    // PV of the last finished iteration, followed first by the next one
+    Move_t bestPv[MAX_PLY];
+    int bestPvLength;
+    bool followPv;  // The node being entered lies on bestPv
+
+    // Quadrants with an odd number of empty squares (see getQuadrantParity)
+    unsigned quadrantParity;
+
+    // Killer moves per ply and history scores per [side][phase][square]
+    Move_t killers[MAX_PLY][2];
+    int history[2][HISTORY_PHASES][64];
+
+    uint64_t maxNodesLimit;
+
+    // Cancellation: stopFlag is owned by AIExtreme and set from other threads
+    const std::atomic<bool>* stopFlag;
+
+    int shallowOrderMinDepth;  // 0 disables shallow-search ordering
+    int shallowOrderDepth;
+
+    int stabilityCutoffMinEmpties;  // 0 disables stability cutoffs
+
+    bool useMtdf;  // Null-window MTD(f) iterations instead of full-window ones
+
+    SearchProgressBuffer* progressSink;  // Owned by AIExtreme, may be null
+    bool pondering;
+
+    /**
+     * @brief Evaluation policy: cached leaf scores, and the incremental
+     * evaluation state and quadrant parity following every move
+     */
+    struct ExtremeEvaluation {
+        SearchEngine* engine;
+
+        int evaluate(const Board_t& board, PlayerColor_t player, uint64_t hash);
+        int evaluateFinal(const Board_t& board, PlayerColor_t player);
+        void play(Move_t move, uint64_t flips, PlayerColor_t player);
+        void undo(Move_t move, uint64_t flips, PlayerColor_t player);
+    };
+
+    /**
+     * @brief Ordering policy: PV, hash move, killers, history, parity and
+     * shallow-search ordering
+     */
+    struct ExtremeOrdering {
+        SearchEngine* engine;
+
+        bool enterNode(int ply);
+        Move_t hashMove(bool onPv, int ply, Move_t tableMove);
+        void order(const Board_t& board,
+            PlayerColor_t player,
+            SearchMove* moves,
+            int count,
+            int ply,
+            Move_t hashMove);
+        const SearchMove& pick(SearchMove* moves, int index, int count);
+        int searchOrderDepth(int depth, Move_t hashMove);
+        void enterChild(bool onPv, int ply, Move_t move);
+        void updatePv(int ply, Move_t move);
+        void onCutoff(const Board_t& board, PlayerColor_t player, Move_t move, int depth, int ply);
+    };
+
+    /**
+     * @brief Pruning policy: alpha-beta plus stability cutoffs in solves
+     */
+    struct ExtremePruning {
+        static constexpr bool enabled = true;
+
+        SearchEngine* engine;
+
+        bool upperBound(const Board_t& board,
+            PlayerColor_t player,
+            int depth,
+            int emptyCount,
+            int alpha,
+            int& score);
+    };
+
+    /**
+     * @brief Table policy: the TT, the endgame table for nodes searched to
+     * the end of the game, and Enhanced Transposition Cutoffs
+     */
+    struct ExtremeTable {
+        typedef uint64_t Key;
+
+        SearchEngine* engine;
+
+        uint64_t rootKey(const Board_t& board, PlayerColor_t player);
+        uint64_t childKey(uint64_t hash, const SearchMove& move, PlayerColor_t player);
+        uint64_t passKey(uint64_t hash);
+        bool probe(uint64_t hash, int depth, int emptyCount, int alpha, int beta, int& score, Move_t& move);
+        void store(uint64_t hash,
+            int depth,
+            int emptyCount,
+            int score,
+            int bound,
+            Move_t bestMove,
+            uint64_t nodes);
+        int probeChildren(uint64_t hash,
+            int depth,
+            int emptyCount,
+            int beta,
+            PlayerColor_t player,
+            const SearchMove* moves,
+            int count,
+            int& score);
+    };
+
+    SearchCore<ExtremeEvaluation, ExtremeOrdering, ExtremePruning, ExtremeTable, PassNodes> core;
 
     bool isTimeUp();
+    int beginSearch(const Board_t& board);
+    void endSearch();
+    int evaluate(const Board_t& board, PlayerColor_t player);
+    int evaluateCached(const Board_t& board, PlayerColor_t player, uint64_t hash);
+
+    int getScorePerDisc() const {
+        return (evalSource == EVAL_SOURCE_HANDCRAFTED) ? FINAL_SCORE_PER_DISC
+                                                       : PATTERN_SCORE_PER_DISC;
+    }
+
     Move_t rootSearch(Board_t& board, PlayerColor_t player, int depth, int alpha, int beta);
-    int negamax(
-        Board_t& board, PlayerColor_t player, int depth, int alpha, int beta, uint64_t hash);
-    void orderMoves(MoveList& moves, const Board_t& board, PlayerColor_t player);
-    int scoreMoveForOrdering(Move_t move, const Board_t& board, PlayerColor_t player);
+    Move_t rootSearchMtdf(Board_t& board, PlayerColor_t player, int depth, int guess);
+    void rootSearchMultiPV(Board_t& board,
+        PlayerColor_t player,
+        int depth,
+        int lineCount,
+        const std::vector<AnalysisLine>& previous,
+        std::vector<AnalysisLine>& lines);
+    void scoreMoves(const Board_t& board,
+        PlayerColor_t player,
+        SearchMove* moves,
+        int count,
+        int ply,
+        Move_t hashMove);
+    static const SearchMove& pickNextMove(SearchMove* moves, int index, int count);
+    int scoreMoveForOrdering(Move_t move,
+        uint64_t flips,
+        const Board_t& board,
+        PlayerColor_t player,
+        int ply);
+    void recordCutoff(Move_t move, const Board_t& board, PlayerColor_t player, int depth, int ply);
+    void resetOrderingTables();
+    void updatePv(int ply, Move_t move);
+    void publishProgress(int depth, bool active);
 };
 
 AIExtreme::SearchEngine::SearchEngine()
-    : nodesSearched(0),
-    cutoffs(0),
+    : endgameTable(ENDGAME_TT_SIZE_MB, 0, "Endgame Table"),
+    useNeuralEval(false),
+    evalSource(EVAL_SOURCE_HANDCRAFTED),
+    etcCutoffs(0),
+    shallowOrderings(0),
+    stabilityCutoffs(0),
+    evalCalls(0),
+    mtdfPasses(0),
     maxDepthReached(0),
-    pvMove(MOVE_NONE),
+    searchSeconds(0.0),
+    tableProbesAtStart(0),
+    tableHitsAtStart(0),
+    rootScore(0),
+    bestPvLength(0),
+    followPv(false),
+    quadrantParity(0),
     maxNodesLimit(DEFAULT_MAX_NODES),
-    timeLimit(TIME_LIMIT_MS / 1000.0) {
+    stopFlag(nullptr),
+    shallowOrderMinDepth(SHALLOW_ORDER_MIN_DEPTH),
+    shallowOrderDepth(SHALLOW_ORDER_DEPTH),
+    stabilityCutoffMinEmpties(STABILITY_CUTOFF_MIN_EMPTIES),
+    useMtdf(false),
+    progressSink(nullptr),
+    pondering(false),
+    core(ExtremeEvaluation{ this }, ExtremeOrdering{ this }, ExtremePruning{ this }, ExtremeTable{ this }) {
+    for (int ply = 0; ply < MAX_PLY; ply++) {
+        killers[ply][0] = MOVE_NONE;
+        killers[ply][1] = MOVE_NONE;
+        depthSeconds[ply] = 0.0;
+        coldDepthSeconds[ply] = 0.0;
+        coldDepthSamples[ply] = 0;
+    }
+    memset(history, 0, sizeof(history));
+}
+
+void AIExtreme::SearchEngine::resetOrderingTables() {
+    // Killers are position specific: clear them for every new root
+    for (int ply = 0; ply < MAX_PLY; ply++) {
+        killers[ply][0] = MOVE_NONE;
+        killers[ply][1] = MOVE_NONE;
+    }
+
+    // History carries over between moves, but older results count for less
+    for (int side = 0; side < 2; side++) {
+        for (int phase = 0; phase < HISTORY_PHASES; phase++) {
+            for (int square = 0; square < 64; square++) {
+                history[side][phase][square] /= 2;
+            }
+        }
+    }
 }
 
 bool AIExtreme::SearchEngine::isTimeUp() {
-    auto currentTime = std::chrono::high_resolution_clock::now();
-    std::chrono::duration<double> elapsed = currentTime - searchStartTime;
-    return elapsed.count() >= timeLimit;
+    return timeManager.hardLimitReached();
 }
 
-Move_t AIExtreme::SearchEngine::search(Board_t& board,
-    PlayerColor_t player,
-    double timeLimitSeconds) {
-    searchStartTime = std::chrono::high_resolution_clock::now();
-    timeLimit = timeLimitSeconds;
-    nodesSearched = 0;
-    cutoffs = 0;
+int AIExtreme::SearchEngine::beginSearch(const Board_t& board) {
+    // Stop requests and the hard time limit are each one atomic load (the
+    // time manager's watcher thread raises the latter), so every node polls
+    core.begin(maxNodesLimit, stopFlag, timeManager.getHardLimitFlag());
+    etcCutoffs = 0;
+    shallowOrderings = 0;
+    stabilityCutoffs = 0;
+    evalCalls = 0;
+    mtdfPasses = 0;
     maxDepthReached = 0;
+    searchSeconds = 0.0;
+    rootScore = 0;
+    bestPvLength = 0;
+
+    resetOrderingTables();
+    quadrantParity = getQuadrantParity(getEmptyBitboard(board));
+
+    EvalSource previousSource = evalSource;
+    if (useNeuralEval && neuralEval.isLoaded()) {
+        evalSource = EVAL_SOURCE_NEURAL;
+        neuralEval.refresh(neuralAccumulator, board);
+    }
+    else if (patternEval.isLoaded()) {
+        evalSource = EVAL_SOURCE_PATTERNS;
+        PatternEvaluator::setBoard(patternState, board);
+    }
+    else {
+        evalSource = EVAL_SOURCE_HANDCRAFTED;
+    }
+
+    // Stored scores are in the previous evaluation's units (and final
+    // margins in its score per disc), so none of them carry over. A table
+    // never probed since its last clear holds nothing and is not swept.
+    if (evalSource != previousSource) {
+        evalCache.clear();
+        if (tt.getHits() + tt.getMisses() > 0)
+            tt.clear();
+        if (endgameTable.getHits() + endgameTable.getMisses() > 0)
+            endgameTable.clear();
+    }
+    evalCache.resetStats();
+
+    // Table statistics accumulate over the game; keep this search's share
+    tableHitsAtStart = tt.getHits() + endgameTable.getHits();
+    tableProbesAtStart = tableHitsAtStart + tt.getMisses() + endgameTable.getMisses();
 
     tt.newSearch();
+    endgameTable.newSearch();
+    publishProgress(0, true);
+
+    int emptyCount = getEmptyCount(board);
+    return (emptyCount <= ENDGAME_THRESHOLD) ? ENDGAME_DEPTH : MAX_SEARCH_DEPTH;
+}
+
+int AIExtreme::SearchEngine::evaluate(const Board_t& board, PlayerColor_t player) {
+    evalCalls++;
+
+    if (evalSource == EVAL_SOURCE_HANDCRAFTED)
+        return evaluator.evaluate(board, player);
 
-    Move_t bestMove = MOVE_NONE;
     int emptyCount = getEmptyCount(board);
+    if (evalSource == EVAL_SOURCE_NEURAL)
+        return neuralEval.evaluate(neuralAccumulator, player, emptyCount);
 
-    int maxDepth = MAX_SEARCH_DEPTH;
-    if (emptyCount <= ENDGAME_THRESHOLD) {
-        maxDepth = ENDGAME_DEPTH;
+    return patternEval.evaluate(patternState, player, emptyCount);
+}
+
+int AIExtreme::SearchEngine::evaluateCached(const Board_t& board, PlayerColor_t player, uint64_t hash) {
+    int score;
+    if (!evalCache.probe(hash, score)) {
+        score = evaluate(board, player);
+        evalCache.store(hash, score);
     }
+    return score;
+}
+
+void AIExtreme::SearchEngine::endSearch() {
+    timeManager.stopClock();
+    searchSeconds = timeManager.elapsed();
+    publishProgress(maxDepthReached, false);
 
-    // Iterative deepening
+    double softLimit, hardLimit;
+    timeManager.getLimits(softLimit, hardLimit);
+
+    uint64_t nodes = core.getNodes();
+    uint64_t cutoffs = core.getCutoffs();
+
+    std::cout << "Search complete: Depth=" << maxDepthReached << " SelDepth=" << core.getSelectiveDepth()
+        << " Nodes=" << nodes
+        << " NPS=" << (uint64_t)(searchSeconds > 0.0 ? nodes / searchSeconds : 0.0)
+        << " Evals=" << evalCalls
+        << " Cutoffs=" << cutoffs << " FirstMoveCut="
+        << (cutoffs > 0 ? (100.0 * core.getFirstMoveCutoffs() / cutoffs) : 0.0) << "%"
+        << " ETC=" << etcCutoffs << " ShallowOrder=" << shallowOrderings
+        << " StabilityCut=" << stabilityCutoffs << " MTDfPasses=" << mtdfPasses
+        << " Limit=" << maxNodesLimit << " Time=" << searchSeconds << "s (soft " << softLimit << "s, hard " << hardLimit
+        << "s)" << std::endl;
+
+    tt.printStats();
+    endgameTable.printStats();
+    evalCache.printStats();
+}
+
+Move_t AIExtreme::SearchEngine::search(Board_t& board, PlayerColor_t player) {
+    int maxDepth = beginSearch(board);
+    Move_t bestMove = MOVE_NONE;
+
+    // Iterative deepening: the time manager decides whether another
+    // iteration fits in this move's budget
     for (int depth = 1; depth <= maxDepth; depth++) {
-        if (isTimeUp())
+        if (depth > 1 && !timeManager.canStartIteration())
             break;
 
-        Move_t currentBest = rootSearch(board, player, depth, -INFINITY_SCORE, INFINITY_SCORE);
+        Move_t currentBest = useMtdf
+            ? rootSearchMtdf(board, player, depth, rootScore)
+            : rootSearch(board, player, depth, -INFINITY_SCORE, INFINITY_SCORE);
 
+        // An aborted iteration still yields a move if the PV move (searched
+        // first) was completed; it is then at least as good as the last one
         if (currentBest != MOVE_NONE) {
             bestMove = currentBest;
-            pvMove = currentBest;
-            maxDepthReached = depth;
+            bestPvLength = pvLength[0];
+            memcpy(bestPv, pvTable[0], bestPvLength * sizeof(Move_t));
+            if (!core.isAborted()) {
+                maxDepthReached = depth;
+                depthSeconds[depth] = timeManager.elapsed();
+            }
         }
 
-        if (isTimeUp())
+        if (core.isAborted() || isTimeUp())
             break;
-    }
 
-    std::cout << "Search complete: Depth=" << maxDepthReached << " Nodes=" << nodesSearched
-        << " Cutoffs=" << cutoffs << " Limit=" << maxNodesLimit << std::endl;
+        timeManager.onIterationComplete(bestMove, depth);
+        publishProgress(depth, true);
+    }
 
-    tt.printStats();
+    endSearch();
 
     return bestMove;
 }
 
-Move_t AIExtreme::SearchEngine::rootSearch(
-    Board_t& board, PlayerColor_t player, int depth, int alpha, int beta) {
-    MoveList moves;
-    getValidMovesAI(board, player, moves);
+void AIExtreme::SearchEngine::searchMultiPV(Board_t& board,
+    PlayerColor_t player,
+    int lineCount,
+    std::vector<AnalysisLine>& lines) {
+    int maxDepth = beginSearch(board);
+    lines.clear();
 
-    if (moves.empty())
-        return MOVE_NONE;
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        if (depth > 1 && !timeManager.canStartIteration())
+            break;
+
+        std::vector<AnalysisLine> current;
+        rootSearchMultiPV(board, player, depth, lineCount, lines, current);
+
+        // An aborted pass has not seen every move; its lines are only
+        // kept when no iteration has finished at all
+        if (!core.isAborted() || lines.empty()) {
+            lines = current;
+            if (!core.isAborted()) {
+                maxDepthReached = depth;
+            }
+        }
+
+        if (!lines.empty()) {
+            bestPvLength = (int)lines[0].pv.size();
+            std::copy(lines[0].pv.begin(), lines[0].pv.end(), bestPv);
+            rootScore = lines[0].score;
+        }
+
+        if (core.isAborted() || isTimeUp() || lines.empty())
+            break;
+
+        timeManager.onIterationComplete(lines[0].move, depth);
+        publishProgress(depth, true);
+    }
+
+    endSearch();
+}
+
+void AIExtreme::SearchEngine::rootSearchMultiPV(Board_t& board,
+    PlayerColor_t player,
+    int depth,
+    int lineCount,
+    const std::vector<AnalysisLine>& previous,
+    std::vector<AnalysisLine>& lines) {
+    uint64_t legalMoves = getValidMovesBitmap(getPlayerBitboard(board, player),
+        getOpponentBitboard(board, player));
+
+    lines.clear();
+    if (legalMoves == 0)
+        return;
+
+    int moveCount = core.prepareMoves(board, player, legalMoves, 0, MOVE_NONE);
+    SearchMove* scored = core.getMoves(0);
+    if (lineCount <= 0 || lineCount > moveCount)
+        lineCount = moveCount;
+
+    // Last iteration's ranking goes first, in order
+    for (int i = 0; i < moveCount; i++) {
+        for (int rank = 0; rank < (int)previous.size(); rank++) {
+            if (previous[rank].move == scored[i].move) {
+                scored[i].score = HASH_MOVE_SCORE - rank;
+                break;
+            }
+        }
+    }
 
     uint64_t hash = tt.computeHash(board, player);
 
-    Move_t ttMove = tt.getBestMove(hash);
-    if (ttMove != MOVE_NONE) {
-        auto it = std::find(moves.begin(), moves.end(), ttMove);
-        if (it != moves.end()) {
-            moves.erase(it);
-            moves.insert(moves.begin(), ttMove);
+    for (int i = 0; i < moveCount; i++) {
+        if (core.checkLimits())
+            break;
+
+        const SearchMove& next = pickNextMove(scored, i, moveCount);
+        Move_t move = next.move;
+        PlayerColor_t nextPlayer = player;
+
+        // Follow this move's own line from the previous iteration
+        bestPvLength = 0;
+        for (const AnalysisLine& line : previous) {
+            if (line.move == move) {
+                bestPvLength = (int)line.pv.size();
+                std::copy(line.pv.begin(), line.pv.end(), bestPv);
+                break;
+            }
+        }
+
+        BoardState_t state = core.applyMove(board, nextPlayer, next);
+        uint64_t nextHash = tt.updateHash(hash, move, next.flips, player);
+
+        // Only a move beating the current K-th best needs an exact score:
+        // test that with a null window, then re-search the few that pass
+        int kthScore = ((int)lines.size() < lineCount) ? -INFINITY_SCORE : lines.back().score;
+        int score = kthScore + 1;
+
+        if (kthScore > -INFINITY_SCORE) {
+            followPv = (bestPvLength > 0);
+            score = -core.search(board, nextPlayer, depth - 1, -kthScore - 1, -kthScore, nextHash, 1);
+        }
+
+        if (!core.isAborted() && score > kthScore) {
+            followPv = (bestPvLength > 0);
+            score = -core.search(board, nextPlayer, depth - 1, -INFINITY_SCORE, -kthScore, nextHash, 1);
+        }
+
+        core.revertMove(board, nextPlayer, state, next);
+
+        if (core.isAborted())
+            break;
+
+        if (score <= kthScore)
+            continue;
+
+        // Exact score: insert in order and keep the best K
+        AnalysisLine line = { move, score, MoveList(1, move) };
+        for (int i = 1; i < pvLength[1]; i++)
+            line.pv.push_back(pvTable[1][i]);
+
+        auto it = std::find_if(lines.begin(), lines.end(),
+            [score](const AnalysisLine& other) { return other.score < score; });
+        lines.insert(it, line);
+        if ((int)lines.size() > lineCount) {
+            lines.pop_back();
         }
     }
+}
+
+Move_t AIExtreme::SearchEngine::rootSearch(Board_t& board,
+    PlayerColor_t player,
+    int depth,
+    int alpha,
+    int beta) {
+    uint64_t legalMoves = getValidMovesBitmap(getPlayerBitboard(board, player),
+        getOpponentBitboard(board, player));
+
+    pvLength[0] = 0;
 
-    orderMoves(moves, board, player);
+    if (legalMoves == 0)
+        return MOVE_NONE;
+
+    uint64_t subtreeStart = core.getNodes();
+    uint64_t hash = tt.computeHash(board, player);
+    int emptyCount = getEmptyCount(board);
+
+    // The previous iteration's PV move goes first, then its whole line
+    Move_t hashMove = bestPvLength > 0 ? bestPv[0]
+        : depth >= emptyCount ? endgameTable.getBestMove(hash)
+        : tt.getBestMove(hash);
+    int moveCount = core.prepareMoves(board, player, legalMoves, 0, hashMove);
+    SearchMove* scored = core.getMoves(0);
 
-    Move_t bestMove = moves[0];
+    Move_t bestMove = MOVE_NONE;
     int bestScore = -INFINITY_SCORE;
     int bound = BOUND_UPPER;
 
-    for (Move_t move : moves) {
-        if (isTimeUp() || nodesSearched >= maxNodesLimit)
+    for (int i = 0; i < moveCount; i++) {
+        if (core.checkLimits())
             break;
 
+        const SearchMove& next = pickNextMove(scored, i, moveCount);
+        Move_t move = next.move;
         PlayerColor_t nextPlayer = player;
-        uint64_t playerBB = getPlayerBitboard(board, player);
-        uint64_t opponentBB = getOpponentBitboard(board, player);
-        uint64_t flips = calculateFlips(playerBB, opponentBB, move);
 
-        BoardState_t state = makeMove(board, nextPlayer, move);
-        uint64_t nextHash = tt.updateHash(hash, move, flips, player);
+        BoardState_t state = core.applyMove(board, nextPlayer, next);
+        uint64_t nextHash = tt.updateHash(hash, move, next.flips, player);
 
-        int score = -negamax(board, nextPlayer, depth - 1, -beta, -alpha, nextHash);
+        followPv = (bestPvLength > 0 && move == bestPv[0]);
+        int score = -core.search(board, nextPlayer, depth - 1, -beta, -alpha, nextHash, 1);
 
-        unmakeMove(board, nextPlayer, state);
+        core.revertMove(board, nextPlayer, state, next);
+
+        // A move whose subtree was cut short has no usable score
+        if (core.isAborted())
+            break;
 
         if (score > bestScore) {
             bestScore = score;
             bestMove = move;
+            updatePv(0, move);
         }
 
         if (score > alpha) {
@@ -342,136 +999,400 @@ Move_t AIExtreme::SearchEngine::rootSearch(
         }
 
         if (alpha >= beta) {
-            cutoffs++;
+            core.countCutoff(i);
             bound = BOUND_LOWER;
             break;
         }
     }
 
-    tt.store(hash, depth, bestScore, bound, bestMove);
+    if (bestMove == MOVE_NONE)
+        return MOVE_NONE;
+
+    if (!core.isAborted()) {
+        core.table.store(hash, depth, emptyCount, bestScore, bound, bestMove, core.getNodes() - subtreeStart);
+        rootScore = bestScore;
+    }
 
     return bestMove;
 }
 
-int AIExtreme::SearchEngine::negamax(
-    Board_t& board, PlayerColor_t player, int depth, int alpha, int beta, uint64_t hash) {
-    nodesSearched++;
+Move_t AIExtreme::SearchEngine::rootSearchMtdf(Board_t& board,
+    PlayerColor_t player,
+    int depth,
+    int guess) {
+    // MTD(f): null-window searches around the guess narrow [lower, upper]
+    // until they meet. Each pass reuses the bounds the previous ones left in
+    // the TT, so most of the tree is cut from the table. Evaluation units are
+    // much finer than a disc, so instead of stepping by one unit the test
+    // value moves by a disc, doubling while one side is open, and bisects
+    // once both bounds are known.
+    int lower = -INFINITY_SCORE;
+    int upper = INFINITY_SCORE;
+    int step = getScorePerDisc();
 
-    int ttScore;
-    Move_t ttMove = MOVE_NONE;
-    if (tt.probe(hash, depth, alpha, beta, ttScore, ttMove)) {
-        return ttScore;
-    }
+    Move_t bestMove = MOVE_NONE;
+    Move_t bestLine[MAX_PLY];
+    int bestLineLength = 0;
 
-    if (depth == 0 || isTerminal(board, player)) {
-        int score = evaluator.evaluate(board, player);
-        tt.store(hash, depth, score, BOUND_EXACT, MOVE_NONE);
-        return score;
-    }
+    while (lower < upper) {
+        int beta;
+        if (lower == -INFINITY_SCORE && upper == INFINITY_SCORE) {
+            beta = guess;
+        }
+        else if (upper == INFINITY_SCORE) {
+            beta = lower + step;
+            step *= 2;
+        }
+        else if (lower == -INFINITY_SCORE) {
+            beta = upper - step + 1;
+            step *= 2;
+        }
+        else {
+            beta = lower + (upper - lower + 1) / 2;
+        }
+        beta = std::clamp(beta, -INFINITY_SCORE + 1, INFINITY_SCORE);
+
+        mtdfPasses++;
+        Move_t move = rootSearch(board, player, depth, beta - 1, beta);
+
+        // A pass cut short proves nothing: keep the previous iteration
+        if (core.isAborted() || move == MOVE_NONE)
+            return MOVE_NONE;
 
-	// Verify node limit every 1024 nodes
-    if ((nodesSearched & 0x3FF) == 0) {
-        if (isTimeUp() || nodesSearched >= maxNodesLimit) {
-            return evaluator.evaluate(board, player);
+        int score = rootScore;
+        if (score < beta) {
+            upper = score;
+        }
+        else {
+            // Only a fail high proves its move reaches the score
+            lower = score;
+            bestMove = move;
+            bestLineLength = pvLength[0];
+            memcpy(bestLine, pvTable[0], bestLineLength * sizeof(Move_t));
         }
     }
 
-    MoveList moves;
-    getValidMovesAI(board, player, moves);
+    // Hand the line of the deciding pass back to the caller
+    pvLength[0] = bestLineLength;
+    memcpy(pvTable[0], bestLine, bestLineLength * sizeof(Move_t));
+    rootScore = lower;
 
-    if (moves.empty()) {
-        PlayerColor_t opponent = getOpponent(player);
+    return bestMove;
+}
 
-        if (!hasValidMoves(board, opponent)) {
-            int finalScore = getScoreDiff(board, player);
-            int score;
-            if (finalScore > 0)
-                score = WIN_SCORE;
-            else if (finalScore < 0)
-                score = LOSE_SCORE;
-            else
-                score = 0;
+void AIExtreme::SearchEngine::updatePv(int ply, Move_t move) {
+    pvTable[ply][ply] = move;
 
-            tt.store(hash, depth, score, BOUND_EXACT, MOVE_NONE);
-            return score;
-        }
+    int childLength = pvLength[ply + 1];
+    for (int i = ply + 1; i < childLength; i++) {
+        pvTable[ply][i] = pvTable[ply + 1][i];
+    }
+
+    pvLength[ply] = std::max(childLength, ply + 1);
+}
+
+void AIExtreme::SearchEngine::getStats(SearchStats& stats) const {
+    uint64_t hits = tt.getHits() + endgameTable.getHits() - tableHitsAtStart;
+    uint64_t probes = tt.getHits() + tt.getMisses() + endgameTable.getHits() +
+        endgameTable.getMisses() - tableProbesAtStart;
+
+    stats.nodes = core.getNodes();
+    stats.nodesPerSecond = (searchSeconds > 0.0) ? stats.nodes / searchSeconds : 0.0;
+    stats.depth = maxDepthReached;
+    stats.selectiveDepth = core.getSelectiveDepth();
+    stats.ttHitRate = (probes > 0) ? (double)hits / probes : 0.0;
+    stats.cutoffs = core.getCutoffs();
+    stats.elapsed = searchSeconds;
+    stats.evalCalls = evalCalls;
+}
+
+void AIExtreme::SearchEngine::publishProgress(int depth, bool active) {
+    if (!progressSink)
+        return;
+
+    SearchProgress progress;
+    progress.active = active;
+    progress.pondering = pondering;
+    progress.depth = depth;
+    progress.score = rootScore;
+    progress.nodes = core.getNodes();
+    progress.elapsed = timeManager.elapsed();
+    progress.pvLength = std::min(bestPvLength, SEARCH_PROGRESS_MAX_PV);
+    memcpy(progress.pv, bestPv, progress.pvLength * sizeof(Move_t));
+
+    progressSink->publish(progress);
+}
+
+// ============================================================================
+// Search Policies
+// ============================================================================
+
+int AIExtreme::SearchEngine::ExtremeEvaluation::evaluate(const Board_t& board,
+    PlayerColor_t player,
+    uint64_t hash) {
+    // At depth 0 only a full board is known to be a finished game
+    if (getEmptyCount(board) == 0)
+        return evaluateFinal(board, player);
 
-        uint64_t passHash = hash ^ tt.getZobristPlayer();
-        return -negamax(board, opponent, depth - 1, -beta, -alpha, passHash);
+    return engine->evaluateCached(board, player, hash);
+}
+
+int AIExtreme::SearchEngine::ExtremeEvaluation::evaluateFinal(const Board_t& board, PlayerColor_t player) {
+    return getScoreDiff(board, player) * engine->getScorePerDisc();
+}
+
+void AIExtreme::SearchEngine::ExtremeEvaluation::play(Move_t move, uint64_t flips, PlayerColor_t player) {
+    engine->quadrantParity ^= 1u << getQuadrant(move);
+    if (engine->evalSource == EVAL_SOURCE_PATTERNS) {
+        PatternEvaluator::play(engine->patternState, move, flips, player);
+    }
+    else if (engine->evalSource == EVAL_SOURCE_NEURAL) {
+        engine->neuralEval.play(engine->neuralAccumulator, move, flips, player);
     }
+}
 
-    if (ttMove != MOVE_NONE) {
-        auto it = std::find(moves.begin(), moves.end(), ttMove);
-        if (it != moves.end()) {
-            moves.erase(it);
-            moves.insert(moves.begin(), ttMove);
-        }
+void AIExtreme::SearchEngine::ExtremeEvaluation::undo(Move_t move, uint64_t flips, PlayerColor_t player) {
+    engine->quadrantParity ^= 1u << getQuadrant(move);
+    if (engine->evalSource == EVAL_SOURCE_PATTERNS) {
+        PatternEvaluator::undo(engine->patternState, move, flips, player);
+    }
+    else if (engine->evalSource == EVAL_SOURCE_NEURAL) {
+        engine->neuralEval.undo(engine->neuralAccumulator, move, flips, player);
     }
+}
 
-    orderMoves(moves, board, player);
+bool AIExtreme::SearchEngine::ExtremeOrdering::enterNode(int ply) {
+    engine->pvLength[ply] = ply;
 
-    int bestScore = -INFINITY_SCORE;
-    Move_t bestMove = moves[0];
-    int bound = BOUND_UPPER;
+    // Only the first child searched on the PV path stays on it
+    bool onPv = engine->followPv && ply < engine->bestPvLength;
+    engine->followPv = false;
+    return onPv;
+}
 
-    for (Move_t move : moves) {
+Move_t AIExtreme::SearchEngine::ExtremeOrdering::hashMove(bool onPv, int ply, Move_t tableMove) {
+    // On the PV path, the previous iteration's move beats the TT move
+    return onPv ? engine->bestPv[ply] : tableMove;
+}
 
-        if (nodesSearched >= maxNodesLimit)
-            break;
+void AIExtreme::SearchEngine::ExtremeOrdering::order(const Board_t& board,
+    PlayerColor_t player,
+    SearchMove* moves,
+    int count,
+    int ply,
+    Move_t hashMove) {
+    engine->scoreMoves(board, player, moves, count, ply, hashMove);
+}
 
-        PlayerColor_t nextPlayer = player;
-        uint64_t playerBB = getPlayerBitboard(board, player);
-        uint64_t opponentBB = getOpponentBitboard(board, player);
-        uint64_t flips = calculateFlips(playerBB, opponentBB, move);
+const SearchMove& AIExtreme::SearchEngine::ExtremeOrdering::pick(SearchMove* moves, int index, int count) {
+    return pickNextMove(moves, index, count);
+}
 
-        BoardState_t state = makeMove(board, nextPlayer, move);
-        uint64_t nextHash = tt.updateHash(hash, move, flips, player);
+int AIExtreme::SearchEngine::ExtremeOrdering::searchOrderDepth(int depth, Move_t hashMove) {
+    // At deep nodes without a hash move static ordering is too weak: replace
+    // it with the scores of a shallow search of each child. A hash move is
+    // already a better first move than the shallow search would find.
+    int minDepth = engine->shallowOrderMinDepth;
+    if (minDepth <= 0 || depth < minDepth || hashMove != MOVE_NONE)
+        return -1;
 
-        int score = -negamax(board, nextPlayer, depth - 1, -beta, -alpha, nextHash);
+    engine->shallowOrderings++;
+    return engine->shallowOrderDepth;
+}
 
-        unmakeMove(board, nextPlayer, state);
+void AIExtreme::SearchEngine::ExtremeOrdering::enterChild(bool onPv, int ply, Move_t move) {
+    engine->followPv = onPv && move == engine->bestPv[ply];
+}
 
-        if (score > bestScore) {
-            bestScore = score;
-            bestMove = move;
-        }
+void AIExtreme::SearchEngine::ExtremeOrdering::updatePv(int ply, Move_t move) {
+    engine->updatePv(ply, move);
+}
 
-        if (score > alpha) {
-            alpha = score;
-            bound = BOUND_EXACT;
+void AIExtreme::SearchEngine::ExtremeOrdering::onCutoff(const Board_t& board,
+    PlayerColor_t player,
+    Move_t move,
+    int depth,
+    int ply) {
+    engine->recordCutoff(move, board, player, depth, ply);
+}
+
+bool AIExtreme::SearchEngine::ExtremePruning::upperBound(const Board_t& board,
+    PlayerColor_t player,
+    int depth,
+    int emptyCount,
+    int alpha,
+    int& score) {
+    // Stability cutoff: when the subtree is solved to the end, the opponent's
+    // stable discs cap our final margin at 64 - 2 * stable. If even that
+    // cannot beat alpha, the node fails low without generating a move.
+    int minEmpties = engine->stabilityCutoffMinEmpties;
+    if (minEmpties <= 0 || emptyCount < minEmpties || depth < emptyCount)
+        return false;
+
+    uint64_t opponentStable = getStableDiscs(getOpponentBitboard(board, player),
+        getPlayerBitboard(board, player));
+    score = (64 - 2 * countBits(opponentStable)) * engine->getScorePerDisc();
+
+    if (score > alpha)
+        return false;
+
+    engine->stabilityCutoffs++;
+    return true;
+}
+
+uint64_t AIExtreme::SearchEngine::ExtremeTable::rootKey(const Board_t& board, PlayerColor_t player) {
+    return engine->tt.computeHash(board, player);
+}
+
+uint64_t AIExtreme::SearchEngine::ExtremeTable::childKey(uint64_t hash,
+    const SearchMove& move,
+    PlayerColor_t player) {
+    return engine->tt.updateHash(hash, move.move, move.flips, player);
+}
+
+uint64_t AIExtreme::SearchEngine::ExtremeTable::passKey(uint64_t hash) {
+    return hash ^ engine->tt.getZobristPlayer();
+}
+
+bool AIExtreme::SearchEngine::ExtremeTable::probe(uint64_t hash,
+    int depth,
+    int emptyCount,
+    int alpha,
+    int beta,
+    int& score,
+    Move_t& move) {
+    // Nodes searched to the end of the game use the endgame table, whose
+    // depth is the number of empty squares
+    if (depth >= emptyCount)
+        return engine->endgameTable.probe(hash, emptyCount, alpha, beta, score, move);
+
+    return engine->tt.probe(hash, depth, alpha, beta, score, move);
+}
+
+void AIExtreme::SearchEngine::ExtremeTable::store(uint64_t hash,
+    int depth,
+    int emptyCount,
+    int score,
+    int bound,
+    Move_t bestMove,
+    uint64_t nodes) {
+    // nodes is the subtree size used by TT_REPLACE_NODES
+    if (depth >= emptyCount)
+        engine->endgameTable.store(hash, emptyCount, score, bound, bestMove, nodes);
+    else
+        engine->tt.store(hash, depth, score, bound, bestMove, nodes);
+}
+
+int AIExtreme::SearchEngine::ExtremeTable::probeChildren(uint64_t hash,
+    int depth,
+    int emptyCount,
+    int beta,
+    PlayerColor_t player,
+    const SearchMove* moves,
+    int count,
+    int& score) {
+    // Enhanced Transposition Cutoff: if any child is already stored with a
+    // bound that refutes our window, cut before searching a single move
+    if (depth < ETC_MIN_DEPTH)
+        return -1;
+
+    bool solving = depth >= emptyCount;
+    TranspositionTable& table = solving ? engine->endgameTable : engine->tt;
+    int tableDepth = solving ? emptyCount : depth;
+    uint64_t childHashes[MAX_MOVES];
+
+    for (int i = 0; i < count; i++) {
+        childHashes[i] = childKey(hash, moves[i], player);
+        table.prefetch(childHashes[i]);
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (table.probeCutoff(childHashes[i], tableDepth - 1, beta, score)) {
+            engine->etcCutoffs++;
+            return i;
         }
+    }
 
-        if (alpha >= beta) {
-            cutoffs++;
-            bound = BOUND_LOWER;
-            bestScore = beta;
-            break;
+    return -1;
+}
+
+void AIExtreme::SearchEngine::scoreMoves(const Board_t& board,
+    PlayerColor_t player,
+    SearchMove* moves,
+    int count,
+    int ply,
+    Move_t hashMove) {
+    for (int i = 0; i < count; i++) {
+        SearchMove& entry = moves[i];
+        entry.score = (entry.move == hashMove)
+            ? HASH_MOVE_SCORE
+            : scoreMoveForOrdering(entry.move, entry.flips, board, player, ply);
+    }
+}
+
+const SearchMove& AIExtreme::SearchEngine::pickNextMove(SearchMove* scored, int index, int count) {
+    // One selection-sort step: moves past a cutoff are never sorted at all
+    int best = index;
+
+    for (int i = index + 1; i < count; i++) {
+        if (scored[i].score > scored[best].score) {
+            best = i;
         }
     }
 
-    tt.store(hash, depth, bestScore, bound, bestMove);
+    if (best != index) {
+        std::swap(scored[index], scored[best]);
+    }
 
-    return bestScore;
+    return scored[index];
 }
 
-void AIExtreme::SearchEngine::orderMoves(MoveList& moves,
+void AIExtreme::SearchEngine::recordCutoff(Move_t move,
     const Board_t& board,
-    PlayerColor_t player) {
-    std::sort(moves.begin(), moves.end(), [this, &board, player](Move_t a, Move_t b) {
-        if (a == pvMove)
-            return true;
-        if (b == pvMove)
-            return false;
+    PlayerColor_t player,
+    int depth,
+    int ply) {
+    if (ply < MAX_PLY && killers[ply][0] != move) {
+        killers[ply][1] = killers[ply][0];
+        killers[ply][0] = move;
+    }
+
+    int phase = getEmptyCount(board) / 16;
+    int* table = history[player][phase];
+    table[move] += depth * depth;
 
-        return scoreMoveForOrdering(a, board, player) > scoreMoveForOrdering(b, board, player);
-        });
+    if (table[move] > HISTORY_LIMIT) {
+        for (int square = 0; square < 64; square++) {
+            table[square] /= 2;
+        }
+    }
 }
 
 int AIExtreme::SearchEngine::scoreMoveForOrdering(Move_t move,
+    uint64_t flips,
     const Board_t& board,
-    PlayerColor_t player) {
+    PlayerColor_t player,
+    int ply) {
     int score = 0;
 
+    if (ply < MAX_PLY) {
+        if (move == killers[ply][0]) {
+            score += KILLER_BONUS_1;
+        }
+        else if (move == killers[ply][1]) {
+            score += KILLER_BONUS_2;
+        }
+    }
+
+    int emptyCount = getEmptyCount(board);
+    score += history[player][emptyCount / 16][move];
+
+    // Late in the game, moving into a region with an odd number of empties
+    // tends to leave us the last move there
+    if (emptyCount <= PARITY_ORDER_MAX_EMPTIES && (quadrantParity & (1u << getQuadrant(move)))) {
+        score += PARITY_BONUS;
+    }
+
     if ((1ULL << move) & CORNERS) {
         score += 10000;
     }
@@ -482,15 +1403,12 @@ int AIExtreme::SearchEngine::scoreMoveForOrdering(Move_t move,
         score += 100;
     }
 
-    uint64_t playerBB = getPlayerBitboard(board, player);
-    uint64_t opponentBB = getOpponentBitboard(board, player);
-    int flips = countBits(calculateFlips(playerBB, opponentBB, move));
-    score += flips * 10;
+    score += countBits(flips) * 10;
 
-    Board_t testBoard = board;
-    PlayerColor_t testPlayer = player;
-    makeMove(testBoard, testPlayer, move);
-    int oppMobility = getMoveCount(testBoard, testPlayer);
+    // Opponent mobility after the move, computed straight from the flips
+    uint64_t playerBB = getPlayerBitboard(board, player) | flips | (1ULL << move);
+    uint64_t opponentBB = getOpponentBitboard(board, player) & ~flips;
+    int oppMobility = countBits(getValidMovesBitmap(opponentBB, playerBB));
     score -= oppMobility * 5;
 
     return score;
@@ -500,8 +1418,20 @@ int AIExtreme::SearchEngine::scoreMoveForOrdering(Move_t move,
 // AIExtreme Main Implementation
 // ============================================================================
 
-AIExtreme::AIExtreme() : moveCount(0) {
+AIExtreme::AIExtreme()
+    : moveCount(0),
+    ponderBoard{ 0, 0 },
+    ponderPlayer(PLAYER_BLACK),
+    ponderMove(MOVE_NONE),
+    ponderSeconds(0.0),
+    ponderDepth(0),
+    ponderHits(0),
+    ponderMisses(0),
+    reusedDepth(-1),
+    ponderSecondsSaved(0.0) {
     engine = std::make_unique<SearchEngine>();
+    engine->setStopFlag(&stopRequested);
+    engine->setProgressSink(&searchProgress);
     book = std::make_unique<OpeningBook>(&engine->tt);  // Share TT with book
 
     int gamesLoaded = -1;
@@ -523,6 +1453,20 @@ AIExtreme::AIExtreme() : moveCount(0) {
             std::cerr << "Expected file: " << filePath.string() << std::endl;
         }
     }
+
+    loadEvalWeights((dbPath / PATTERN_WEIGHTS_FILE).string());
+
+    // The built-in stage table is used unless a tuned one is provided
+    fs::path stagePath = dbPath / EVAL_STAGE_FILE;
+    if (fs::exists(stagePath)) {
+        loadStageWeights(stagePath.string());
+    }
+
+    // Loaded for setNeuralEvaluation(); not used unless enabled
+    fs::path networkPath = dbPath / NNUE_WEIGHTS_FILE;
+    if (fs::exists(networkPath)) {
+        loadNeuralWeights(networkPath.string());
+    }
 }
 
 AIExtreme::~AIExtreme() = default;
@@ -545,11 +1489,14 @@ Move_t AIExtreme::getBestMove(GameModel& model) {
     if (totalPieces <= 6) {
         // This is early game - reset counter
         moveCount = 0;
+        ponderMove = MOVE_NONE;  // Left over from the previous game
     }
 
     Board_t board = model.board;
     PlayerColor_t player = model.currentPlayer;
 
+    checkPonderHit(board);
+
     std::vector<Move_t> validMoves;
     getValidMovesAI(board, player, validMoves);
 
@@ -609,9 +1556,10 @@ Move_t AIExtreme::getBestMove(GameModel& model) {
         testedMakeUnmake = true;
     }
 
-    // Not in book - use search
-    double timeLimit = TIME_LIMIT_MS / 1000.0;
-    Move_t bestMove = engine->search(board, player, timeLimit);
+    // Not in book - use search, budgeted from the side's game clock
+    engine->timeManager.startMove(model.playerTime[player], getEmptyCount(board));
+    Move_t bestMove = engine->search(board, player);
+    recordPonderSaving();
 
     if (bestMove == MOVE_NONE) {
         bestMove = validMoves[0];
@@ -621,26 +1569,219 @@ Move_t AIExtreme::getBestMove(GameModel& model) {
     return bestMove;
 }
 
-void AIExtreme::getSearchStats(int& nodesSearched, int& maxDepth) const {
+void AIExtreme::ponder(const GameModel& model) {
+    Board_t board = model.board;
+    PlayerColor_t player = model.currentPlayer;
+
+    ponderMove = MOVE_NONE;
+
+    if (getValidMovesBitmap(getPlayerBitboard(board, player),
+        getOpponentBitboard(board, player)) == 0) {
+        return;
+    }
+
+    // Searching from the opponent's side covers all of its replies; the
+    // subtree of the predicted one gets most of the effort. The node budget
+    // bounds move latency, which pondering does not add to, so it is lifted
+    uint64_t nodeLimit = engine->getMaxNodes();
+    engine->setMaxNodes(std::numeric_limits<uint64_t>::max());
+    engine->timeManager.startPondering();
+    engine->setPondering(true);
+
+    std::cout << "[Ponder] Searching on the opponent's time..." << std::endl;
+    Move_t predicted = engine->search(board, player);
+
+    engine->setPondering(false);
+    engine->setMaxNodes(nodeLimit);
+
+    ponderBoard = board;
+    ponderPlayer = player;
+    ponderMove = predicted;
+    ponderSeconds = engine->timeManager.elapsed();
+    ponderDepth = engine->getMaxDepth();
+}
+
+bool AIExtreme::loadStageWeights(const std::string& path) {
+    if (engine->loadStageWeights(path)) {
+        std::cout << "Evaluation stage weights loaded from " << path << std::endl;
+        return true;
+    }
+
+    std::cerr << "Warning: Stage weights not loaded from " << path
+              << ". Using the built-in table." << std::endl;
+    return false;
+}
+
+bool AIExtreme::loadNeuralWeights(const std::string& path) {
+    if (engine->loadNeuralWeights(path)) {
+        std::cout << "Neural network loaded from " << path << " ("
+                  << NeuralEvaluator::getInstructionSet() << ")" << std::endl;
+        return true;
+    }
+
+    std::cerr << "Warning: Neural network not loaded from " << path << std::endl;
+    return false;
+}
+
+bool AIExtreme::loadEvalWeights(const std::string& path) {
+    if (engine->loadPatternWeights(path)) {
+        std::cout << "Pattern evaluation weights loaded from " << path << std::endl;
+        return true;
+    }
+
+    std::cerr << "Warning: Pattern weights not loaded. AI will use the hand-crafted evaluation."
+              << std::endl;
+    std::cerr << "Expected file: " << path << " (see tools/trainer)" << std::endl;
+    return false;
+}
+
+void AIExtreme::analyze(const GameModel& model, int lineCount, std::vector<AnalysisLine>& lines) {
+    Board_t board = model.board;
+    PlayerColor_t player = model.currentPlayer;
+
+    // No opening book here: every move gets a searched score
+    engine->timeManager.startMove(model.playerTime[player], getEmptyCount(board));
+    engine->searchMultiPV(board, player, lineCount, lines);
+
+    for (const AnalysisLine& line : lines) {
+        std::cout << "[Analysis] " << (char)('A' + getMoveX(line.move)) << (getMoveY(line.move) + 1)
+            << " score=" << line.score << " pv_length=" << line.pv.size() << std::endl;
+    }
+}
+
+void AIExtreme::checkPonderHit(const Board_t& board) {
+    reusedDepth = -1;
+    if (ponderMove == MOVE_NONE) {
+        return;
+    }
+
+    // Hit if the opponent played the predicted reply: the TT then already
+    // holds this position's subtree, so iterative deepening starts warm
+    Board_t expected = ponderBoard;
+    PlayerColor_t expectedPlayer = ponderPlayer;
+    makeMove(expected, expectedPlayer, ponderMove);
+
+    bool hit = (expected.black == board.black && expected.white == board.white);
+    if (hit) {
+        ponderHits++;
+        // The ponder search reached ponderDepth from the parent position
+        reusedDepth = ponderDepth - 1;
+    }
+    else {
+        ponderMisses++;
+    }
+
+    int total = ponderHits + ponderMisses;
+    std::cout << "[Ponder] " << (hit ? "Hit" : "Miss") << ": predicted "
+        << (char)('A' + getMoveX(ponderMove)) << (getMoveY(ponderMove) + 1) << " after "
+        << ponderSeconds << "s (depth " << ponderDepth << ") | hit rate "
+        << (100.0 * ponderHits / total) << "% (" << ponderHits << "/" << total << ")"
+        << std::endl;
+
+    ponderMove = MOVE_NONE;
+}
+
+void AIExtreme::recordPonderSaving() {
+    if (reusedDepth < 0) {
+        engine->recordColdSearch();
+        return;
+    }
+
+    // Saving = how much sooner the warm search completed a depth than cold
+    // searches do on average. Cold searches often stop short of the pondered
+    // depth, so the deepest depth both completed is compared.
+    int depth = reusedDepth;
+    while (depth > 0 &&
+           (engine->getDepthSeconds(depth) < 0.0 || engine->getColdDepthSeconds(depth) < 0.0)) {
+        depth--;
+    }
+    if (depth == 0) {
+        std::cout << "[Ponder] No cold search to compare with yet" << std::endl;
+        return;
+    }
+
+    double warmSeconds = engine->getDepthSeconds(depth);
+    double coldSeconds = engine->getColdDepthSeconds(depth);
+    double saved = coldSeconds - warmSeconds;
+    ponderSecondsSaved += saved;
+    std::cout << "[Ponder] Depth " << depth << " completed after " << warmSeconds
+              << "s (cold average " << coldSeconds << "s): saved " << saved
+              << "s | time saved " << ponderSecondsSaved << "s" << std::endl;
+}
+
+void AIExtreme::getSearchStats(SearchStats& stats) const {
+    stats = SearchStats{};
     if (engine) {
-        nodesSearched = engine->getNodesSearched();
-        maxDepth = engine->getMaxDepth();
+        engine->getStats(stats);
+    }
+}
+
+void AIExtreme::getPrincipalVariation(MoveList& pv) const {
+    if (engine) {
+        engine->getPV(pv);
     }
     else {
-        nodesSearched = 0;
-        maxDepth = 0;
+        pv.clear();
+    }
+}
+
+void AIExtreme::setShallowOrdering(int minDepth, int shallowDepth) {
+    if (engine) {
+        engine->setShallowOrdering(minDepth, shallowDepth);
+    }
+}
+
+void AIExtreme::setStabilityCutoff(int minEmpties) {
+    if (engine) {
+        engine->setStabilityCutoff(minEmpties);
+    }
+}
+
+void AIExtreme::setMtdf(bool enabled) {
+    if (engine) {
+        engine->setMtdf(enabled);
+    }
+}
+
+void AIExtreme::setTableReplacement(TTReplacement policy) {
+    if (engine) {
+        engine->setTableReplacement(policy);
+    }
+}
+
+bool AIExtreme::setNeuralEvaluation(bool enabled) {
+    bool active = engine->setNeuralEvaluation(enabled);
+    if (enabled && !active) {
+        std::cerr << "Warning: Neural evaluation requested but no network is loaded." << std::endl;
     }
+    return active;
 }
 
 // Implementation of new methods for node limit
-void AIExtreme::setNodeLimit(int limit) {
+void AIExtreme::setNodeLimit(uint64_t limit) {
     if (engine) {
         engine->setMaxNodes(limit);
         std::cout << "[AIExtreme] Node limit set to: " << limit << std::endl;
     }
 }
 
-int AIExtreme::getNodeLimit() const {
+void AIExtreme::setTimeLimits(double softSeconds, double hardSeconds) {
+    if (engine) {
+        engine->timeManager.setLimits(softSeconds, hardSeconds);
+    }
+}
+
+void AIExtreme::getTimeLimits(double& softSeconds, double& hardSeconds) const {
+    if (engine) {
+        engine->timeManager.getLimits(softSeconds, hardSeconds);
+    }
+    else {
+        softSeconds = 0.0;
+        hardSeconds = 0.0;
+    }
+}
+
+uint64_t AIExtreme::getNodeLimit() const {
     if (engine) {
         return engine->getMaxNodes();
     }
@@ -19,7 +19,11 @@
 #include <memory>
 #include <vector>
 
+#include "eval_cache.h"
+#include "nnue_eval.h"
 #include "opening_book.h"
+#include "pattern_eval.h"
+#include "time_manager.h"
 #include "transposition_table.h"
 #include "ai_interface.h"
 
@@ -37,6 +41,22 @@ private:
     std::unique_ptr<OpeningBook> book;
     int moveCount;  // Track move number for book depth
 
+    // Last ponder search: position (opponent to move) and the reply it predicts
+    Board_t ponderBoard;
+    PlayerColor_t ponderPlayer;
+    Move_t ponderMove;      // MOVE_NONE when there is nothing to match
+    double ponderSeconds;
+    int ponderDepth;
+
+    // Ponder statistics for the current session
+    int ponderHits;
+    int ponderMisses;
+    int reusedDepth;            // Depth pondered below the current position, -1 if cold
+    double ponderSecondsSaved;  // Summed over hits, against the cold average
+
+    void checkPonderHit(const Board_t& board);
+    void recordPonderSaving();
+
 public:
     AIExtreme();
     virtual ~AIExtreme();
@@ -48,15 +68,76 @@ public:
      */
     int loadOpeningBook(const std::string& path);
 
+    /**
+     * @brief Loads pattern evaluation weights (written by the trainer)
+     * @param path Path to the weight file
+     * @return True if loaded; otherwise the hand-crafted evaluation is used
+     */
+    bool loadEvalWeights(const std::string& path);
+
+    /**
+     * @brief Loads per-stage weights for the hand-crafted evaluation terms
+     * @param path Text file of knots (see Evaluator::loadStageWeights)
+     * @return True if loaded; otherwise the current table is kept
+     */
+    bool loadStageWeights(const std::string& path);
+
+    /**
+     * @brief Loads a neural network (written by the trainer with --nnue)
+     * @param path Path to the network file
+     * @return True if loaded; it is used only after setNeuralEvaluation(true)
+     */
+    bool loadNeuralWeights(const std::string& path);
+
+    /**
+     * @brief Selects the neural network over the pattern evaluation
+     *
+     * Takes effect at the next search. Off by default.
+     *
+     * @param enabled True to evaluate with the network when one is loaded
+     * @return True if the network will be used
+     */
+    bool setNeuralEvaluation(bool enabled);
+
+    /**
+     * @brief Tunes shallow-search move ordering at high-depth nodes
+     * @param minDepth Minimum remaining depth to order by shallow search (0 = off)
+     * @param shallowDepth Depth of the search run on each child
+     */
+    void setShallowOrdering(int minDepth, int shallowDepth);
+
+    /**
+     * @brief Tunes stability cutoffs in the endgame solver
+     * @param minEmpties Fewest empty squares at which the stable-disc bound
+     *                   is computed (0 = off, negative = default)
+     */
+    void setStabilityCutoff(int minEmpties);
+
+    /**
+     * @brief Switches iterative deepening to MTD(f) null-window iterations
+     */
+    void setMtdf(bool enabled);
+
+    /**
+     * @brief Chooses which entry the TT and endgame table keep on a
+     * collision: the deeper one, or the one with the larger subtree
+     */
+    void setTableReplacement(TTReplacement policy);
+
     virtual Move_t getBestMove(GameModel& model) override;
+    virtual void ponder(const GameModel& model) override;
+    virtual void analyze(const GameModel& model, int lineCount, std::vector<AnalysisLine>& lines) override;
 
     virtual const char* getName() const override {
         return "Extreme AI (Advanced Search + TT)";
     }
 
-    virtual void getSearchStats(int& nodesSearched, int& maxDepth) const override;
-    virtual void setNodeLimit(int limit) override;
-    virtual int getNodeLimit() const override;
+    virtual void getSearchStats(SearchStats& stats) const override;
+    virtual void getPrincipalVariation(MoveList& pv) const override;
+    virtual void setNodeLimit(uint64_t limit) override;
+    virtual uint64_t getNodeLimit() const override;
+    virtual void setTimeLimits(double softSeconds, double hardSeconds) override;
+    virtual void getTimeLimits(double& softSeconds, double& hardSeconds) const override;
 };
 
 #endif // AI_EXTREME_H
\ No newline at end of file
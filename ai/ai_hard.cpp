@@ -12,11 +12,11 @@
 
 #include "ai_hard.h"
 #include <algorithm>
-#include <limits>
+#include <chrono>
 #include <iostream>
 
  // Positional weights: corners are highly valuable, edges are good, center is neutral
-const int AIHard::POSITION_WEIGHTS[64] = {
+static const int POSITION_WEIGHTS[64] = {
      500, -150, 30, 10, 10, 30, -150,  500,
     -150, -250,  0,  0,  0,  0, -250, -150,
       30,    0,  1,  2,  2,  1,    0,   30,
@@ -27,28 +27,18 @@ const int AIHard::POSITION_WEIGHTS[64] = {
      500, -150, 30, 10, 10, 30, -150,  500
 };
 
-AIHard::AIHard() : nodesExplored(0), maxNodes(DEFAULT_NODE_LIMIT) {
-    std::cout << "[AIHard] Initialized with node limit: " << maxNodes << std::endl;
-}
+int HardEvaluation::evaluateFinal(const Board_t& board, PlayerColor_t player) const {
+    int diff = getScoreDiff(board, player);
 
-GameModel AIHard::copyModel(const GameModel& model) const {
-    return model;
+    if (diff > 0) return 100000;
+    if (diff < 0) return -100000;
+    return 0;
 }
 
-int AIHard::evaluateBoard(const GameModel& model, PlayerColor_t maximizingPlayer) const {
-    // Terminal position evaluation
-    if (model.gameOver) {
-        int myScore = countBits(getPlayerBitboard(model.board, maximizingPlayer));
-        int oppScore = countBits(getOpponentBitboard(model.board, maximizingPlayer));
-
-        if (myScore > oppScore) return 100000;
-        if (myScore < oppScore) return -100000;
-        return 0;
-    }
-
+int HardEvaluation::evaluate(const Board_t& board, PlayerColor_t player, NoTable::Key) const {
     int score = 0;
-    uint64_t myBoard = getPlayerBitboard(model.board, maximizingPlayer);
-    uint64_t oppBoard = getOpponentBitboard(model.board, maximizingPlayer);
+    uint64_t myBoard = getPlayerBitboard(board, player);
+    uint64_t oppBoard = getOpponentBitboard(board, player);
 
     // Positional evaluation using weight table
     for (int i = 0; i < 64; i++) {
@@ -59,8 +49,13 @@ int AIHard::evaluateBoard(const GameModel& model, PlayerColor_t maximizingPlayer
     }
 
     // Mobility evaluation - difference in available moves
-    int myMobility = getMoveCount(model.board, maximizingPlayer);
-    int oppMobility = getMoveCount(model.board, getOpponent(maximizingPlayer));
+    int myMobility = getMoveCount(board, player);
+    int oppMobility = getMoveCount(board, getOpponent(player));
+
+    // Terminal position evaluation
+    if (myMobility == 0 && oppMobility == 0) {
+        return evaluateFinal(board, player);
+    }
 
     int totalPieces = countBits(myBoard | oppBoard);
 
@@ -80,107 +75,38 @@ int AIHard::evaluateBoard(const GameModel& model, PlayerColor_t maximizingPlayer
     }
 
     // Corner control bonus
-    score += countRegion(model.board, maximizingPlayer, CORNERS) * 500;
-    score -= countRegion(model.board, getOpponent(maximizingPlayer), CORNERS) * 500;
+    score += countRegion(board, player, CORNERS) * 500;
+    score -= countRegion(board, getOpponent(player), CORNERS) * 500;
 
     return score;
 }
 
-int AIHard::alphaBeta(GameModel& model, int depth, int alpha, int beta,
-    bool isMaximizing, PlayerColor_t maximizingPlayer) const {
-    nodesExplored++;
-
-    if (nodesExplored >= maxNodes) {
-        return evaluateBoard(model, maximizingPlayer);
-    }
-
-    // Search termination conditions
-    if (depth == 0 || model.gameOver) {
-        return evaluateBoard(model, maximizingPlayer);
-    }
-
-    MoveList validMoves;
-    getValidMoves(model, validMoves);
-
-    // Handle pass moves
-    if (validMoves.empty()) {
-        GameModel nextModel = copyModel(model);
-        nextModel.currentPlayer = getOpponent(nextModel.currentPlayer);
-
-        MoveList oppMoves;
-        getValidMoves(nextModel, oppMoves);
-
-        if (oppMoves.empty()) {
-            nextModel.gameOver = true;
-            return evaluateBoard(nextModel, maximizingPlayer);
-        }
-
-        // Opponent gets to move
-        return alphaBeta(nextModel, depth - 1, alpha, beta, !isMaximizing, maximizingPlayer);
-    }
-
+void HardOrdering::order(const Board_t&, PlayerColor_t, SearchMove* moves, int count, int, Move_t) {
     // Move ordering for better pruning - corners first
-    std::sort(validMoves.begin(), validMoves.end(), [this](Move_t a, Move_t b) {
-        return POSITION_WEIGHTS[a] > POSITION_WEIGHTS[b];
+    std::sort(moves, moves + count, [](const SearchMove& a, const SearchMove& b) {
+        return POSITION_WEIGHTS[a.move] > POSITION_WEIGHTS[b.move];
         });
+}
 
-    if (isMaximizing) {
-        int maxEval = std::numeric_limits<int>::min();
-
-        for (Move_t move : validMoves) {
-            if (nodesExplored >= maxNodes) break;  // Early exit
-
-            GameModel nextModel = copyModel(model);
-            playMove(nextModel, move);
-
-            int eval = alphaBeta(nextModel, depth - 1, alpha, beta, false, maximizingPlayer);
-            maxEval = std::max(maxEval, eval);
-            alpha = std::max(alpha, eval);
-
-            // Beta pruning - opponent won't allow this path
-            if (beta <= alpha) {
-                break;
-            }
-        }
-
-        return maxEval;
-    }
-    else {
-        int minEval = std::numeric_limits<int>::max();
-
-        for (Move_t move : validMoves) {
-            if (nodesExplored >= maxNodes) break;  // Early exit
-
-            GameModel nextModel = copyModel(model);
-            playMove(nextModel, move);
-
-            int eval = alphaBeta(nextModel, depth - 1, alpha, beta, true, maximizingPlayer);
-            minEval = std::min(minEval, eval);
-            beta = std::min(beta, eval);
-
-            // Alpha pruning - we won't choose this path
-            if (beta <= alpha) {
-                break;
-            }
-        }
-
-        return minEval;
-    }
+AIHard::AIHard()
+    : searchDepth(MAX_DEPTH),
+      searchSeconds(0.0),
+      maxNodes(DEFAULT_NODE_LIMIT) {
+    std::cout << "[AIHard] Initialized with node limit: " << maxNodes << std::endl;
 }
 
 Move_t AIHard::getBestMove(GameModel& model) {
-    nodesExplored = 0;
+    core.begin(maxNodes, &stopRequested);
+    searchSeconds = 0.0;
 
-    MoveList validMoves;
-    getValidMoves(model, validMoves);
-
-    if (validMoves.empty()) {
+    PlayerColor_t currentPlayer = getCurrentPlayer(model);
+    if (!hasValidMoves(model.board, currentPlayer)) {
         return MOVE_NONE;
     }
 
     // Dynamic depth adjustment based on game phase
     int totalPieces = getDiscCount(model.board);
-    int searchDepth = MAX_DEPTH;
+    searchDepth = MAX_DEPTH;
 
     if (totalPieces > 52) {
         // Endgame - search deeper when fewer moves remain
@@ -191,32 +117,23 @@ Move_t AIHard::getBestMove(GameModel& model) {
         searchDepth = MAX_DEPTH - 2;
     }
 
-    PlayerColor_t currentPlayer = getCurrentPlayer(model);
-    Move_t bestMove = validMoves[0];
-    int bestScore = std::numeric_limits<int>::min();
-
     std::cout << "[AIHard] Searching depth " << searchDepth
         << " (node limit: " << maxNodes << ")..." << std::endl;
 
-    // Evaluate each move with alpha-beta search
-    for (Move_t move : validMoves) {
-        if (nodesExplored >= maxNodes) {
-            break;
-        }
-
-        GameModel nextModel = copyModel(model);
-        playMove(nextModel, move);
-
-        int score = alphaBeta(nextModel, searchDepth - 1,
-            std::numeric_limits<int>::min(),
-            std::numeric_limits<int>::max(),
-            false, currentPlayer);
-
-        if (score > bestScore) {
-            bestScore = score;
-            bestMove = move;
-        }
-    }
+    auto startTime = std::chrono::steady_clock::now();
+    Move_t bestMove = core.searchRoot(model.board, currentPlayer, searchDepth);
+    searchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
 
     return bestMove;
-}
\ No newline at end of file
+}
+
+void AIHard::getSearchStats(SearchStats& stats) const {
+    stats = SearchStats{};
+    stats.nodes = core.getNodes();
+    stats.nodesPerSecond = (searchSeconds > 0.0) ? stats.nodes / searchSeconds : 0.0;
+    stats.depth = searchDepth;
+    stats.selectiveDepth = core.getSelectiveDepth();
+    stats.cutoffs = core.getCutoffs();
+    stats.elapsed = searchSeconds;
+    stats.evalCalls = core.getEvalCalls();
+}
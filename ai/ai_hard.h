@@ -14,7 +14,27 @@
 #define AI_HARD_H
 
 #include "ai_interface.h"
-#include <vector>
+#include "search_core.h"
+
+/**
+ * @brief Positional weights, mobility, corners and (late) disc count
+ */
+struct HardEvaluation : StaticEvaluation {
+    int evaluate(const Board_t& board, PlayerColor_t player, NoTable::Key) const;
+    int evaluateFinal(const Board_t& board, PlayerColor_t player) const;
+};
+
+/**
+ * @brief Moves on heavier positional weights (corners) first
+ */
+struct HardOrdering : NoOrdering {
+    void order(const Board_t& board,
+        PlayerColor_t player,
+        SearchMove* moves,
+        int count,
+        int ply,
+        Move_t hashMove);
+};
 
 /**
  * @brief Hard AI using Minimax with Alpha-Beta pruning
@@ -25,29 +45,10 @@
         static const int MAX_DEPTH = 8;
         static const int DEFAULT_NODE_LIMIT = 500000;  // Higher limit due to better pruning
 
-        // Positional weight table emphasizing corners and edges
-        static const int POSITION_WEIGHTS[64];
-
-        mutable int nodesExplored;
-        int maxNodes;  // Dynamic node limit
-
-        /**
-         * @brief Creates a copy of the game model for simulation
-         */
-        inline GameModel copyModel(const GameModel& model) const;
-
-        /**
-         * @brief Advanced board evaluation with multiple heuristics
-         * Combines positional scoring, mobility, corner control, and piece count
-         */
-        int evaluateBoard(const GameModel& model, PlayerColor_t maximizingPlayer) const;
-
-        /**
-         * @brief Minimax search with Alpha-Beta pruning
-         * Explores game tree to specified depth with move ordering
-         */
-        int alphaBeta(GameModel& model, int depth, int alpha, int beta,
-            bool isMaximizing, PlayerColor_t maximizingPlayer) const;
+        SearchCore<HardEvaluation, HardOrdering, AlphaBetaPruning, NoTable, ImplicitPasses> core;
+        int searchDepth;       // Nominal depth of the last search
+        double searchSeconds;  // Duration of the last search
+        uint64_t maxNodes;     // Dynamic node limit
 
     public:
         AIHard();
@@ -58,16 +59,13 @@
             return "Hard AI (Alpha-Beta)";
         }
 
-        virtual void getSearchStats(int& nodesSearched, int& maxDepth) const override {
-            nodesSearched = this->nodesExplored;
-            maxDepth = MAX_DEPTH;
-        }
+        virtual void getSearchStats(SearchStats& stats) const override;
 
-        virtual void setNodeLimit(int limit) override {
+        virtual void setNodeLimit(uint64_t limit) override {
             maxNodes = (limit > 0) ? limit : DEFAULT_NODE_LIMIT;
         }
 
-        virtual int getNodeLimit() const override {
+        virtual uint64_t getNodeLimit() const override {
             return maxNodes;
         }
 };
@@ -13,7 +13,11 @@
 #ifndef AI_INTERFACE_H
 #define AI_INTERFACE_H
 
+#include <atomic>
+#include <cstdint>
+
 #include "../model.h"
+#include "search_progress.h"
 
  /**
   * @brief AI difficulty levels
@@ -25,6 +29,29 @@ enum AIDifficulty {
     AI_EXTREME    // Negamax with Transposition Tables
 };
 
+/**
+ * @brief Statistics of the last search (zero where an AI has no such notion)
+ */
+struct SearchStats {
+    uint64_t nodes;         // Positions visited
+    double nodesPerSecond;
+    int depth;              // Nominal depth of the last completed search
+    int selectiveDepth;     // Deepest ply actually reached
+    double ttHitRate;       // Transposition table hits / probes (0..1)
+    uint64_t cutoffs;       // Beta (or alpha) cutoffs
+    double elapsed;         // Seconds spent searching
+    uint64_t evalCalls;     // Static evaluations (cache hits not counted)
+};
+
+/**
+ * @brief One ranked root move of a multi-PV analysis
+ */
+struct AnalysisLine {
+    Move_t move;
+    int score;    // Exact score for the side to move
+    MoveList pv;  // Expected line, starting with move
+};
+
 /**
  * @brief Abstract base class for all AI implementations
  * Enables polymorphism and easy swapping of AI strategies
@@ -33,6 +60,23 @@ class AIInterface {
 protected:
     AIInterface() = default;
 
+    /**
+     * @brief Set by stop() from another thread; searches poll it and unwind
+     */
+    std::atomic<bool> stopRequested{ false };
+
+    /**
+     * @brief Checks whether the running search has been asked to stop
+     */
+    bool shouldStop() const {
+        return stopRequested.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Progress snapshots, published by the search thread
+     */
+    SearchProgressBuffer searchProgress;
+
 public:
     virtual ~AIInterface() = default;
 
@@ -49,13 +93,45 @@ public:
     virtual const char* getName() const = 0;
 
     /**
-     * @brief Retrieves search statistics if available
-     * @param nodesSearched Number of nodes explored
-     * @param maxDepth Maximum search depth reached
+     * @brief Retrieves statistics of the last search
+     * @param stats Receives the statistics (all zero if the AI does not search)
+     */
+    virtual void getSearchStats(SearchStats& stats) const {
+        stats = SearchStats{};
+    }
+
+    /**
+     * @brief Retrieves the principal variation of the last search
+     * @param pv Receives the expected line, best move first (MOVE_PASS marks
+     *           a pass); empty if the AI does not track one
      */
-    virtual void getSearchStats(int& nodesSearched, int& maxDepth) const {
-        nodesSearched = 0;
-        maxDepth = 0;
+    virtual void getPrincipalVariation(MoveList& pv) const {
+        pv.clear();
+    }
+
+    /**
+     * @brief Ranks the best root moves of a position (analysis mode)
+     * @param model Position to analyze
+     * @param lineCount Number of moves to rank (0 = all legal moves)
+     * @param lines Receives the moves, best first, with scores and PVs
+     *
+     * Default implementation returns no lines - only searching AIs rank moves
+     */
+    virtual void analyze(const GameModel& /*model*/,
+        int /*lineCount*/,
+        std::vector<AnalysisLine>& lines) {
+        lines.clear();
+    }
+
+    /**
+     * @brief Fetches the newest progress snapshot without blocking
+     * @param progress Receives the snapshot
+     * @return False if nothing new was published (or the AI publishes nothing)
+     *
+     * Call from a single thread (the render loop).
+     */
+    bool readSearchProgress(SearchProgress& progress) {
+        return searchProgress.read(progress);
     }
 
     /**
@@ -65,7 +141,7 @@ public:
      * Default implementation does nothing - subclasses that support
      * node limiting should override this method
      */
-    virtual void setNodeLimit(int limit) {
+    virtual void setNodeLimit(uint64_t limit) {
         // Default: no-op for AIs that don't use node limits (e.g., Easy AI)
     }
 
@@ -73,10 +149,62 @@ public:
      * @brief Gets current node limit
      * @return Current maximum nodes, or 0 if unlimited
      */
-    virtual int getNodeLimit() const {
+    virtual uint64_t getNodeLimit() const {
         return 0;  // Default: unlimited
     }
 
+    /**
+     * @brief Sets per-move thinking time limits
+     * @param softSeconds Planned time per move (0 = derive from game clock)
+     * @param hardSeconds Absolute ceiling per move (0 = derive from game clock)
+     *
+     * Default implementation does nothing - only time-managed AIs use it
+     */
+    virtual void setTimeLimits(double /*softSeconds*/, double /*hardSeconds*/) {
+        // Default: no-op for AIs that are not time managed
+    }
+
+    /**
+     * @brief Gets the time limits used for the current (or last) move
+     * @param softSeconds Planned time per move, 0 if not time managed
+     * @param hardSeconds Absolute ceiling per move, 0 if not time managed
+     */
+    virtual void getTimeLimits(double& softSeconds, double& hardSeconds) const {
+        softSeconds = 0.0;
+        hardSeconds = 0.0;
+    }
+
+    /**
+     * @brief Searches on the opponent's time (runs until stop())
+     * @param model Game state with the opponent to move
+     *
+     * Work done here is reused by the next getBestMove() if the opponent
+     * plays the predicted reply. Default implementation does nothing.
+     */
+    virtual void ponder(const GameModel& /*model*/) {
+        // Default: no-op for AIs with nothing to reuse between moves
+    }
+
+    /**
+     * @brief Asks a running getBestMove() to return as soon as possible
+     *
+     * Thread-safe. The search returns the best move found so far (or
+     * MOVE_NONE if it had not finished a single root move).
+     */
+    void stop() {
+        stopRequested.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Clears a previous stop() request
+     *
+     * Must be called before starting a new search (not from inside
+     * getBestMove(), so a stop() issued right after launch is not lost).
+     */
+    void clearStop() {
+        stopRequested.store(false, std::memory_order_relaxed);
+    }
+
     /**
      * @brief Resets internal AI state if needed
      */
@@ -11,130 +11,59 @@
  */
 
 #include "ai_normal.h"
-#include <algorithm>
-#include <limits>
+#include <chrono>
 #include <iostream>
 
-AINormal::AINormal() : nodesExplored(0), maxNodes(DEFAULT_NODE_LIMIT) {
-    std::cout << "[AINormal] Initialized with node limit: " << maxNodes << std::endl;
-}
-
-GameModel AINormal::copyModel(const GameModel& model) const {
-    return model;
-}
-
-int AINormal::evaluateBoard(const GameModel& model, PlayerColor_t maximizingPlayer) const {
-    // Simple evaluation: piece count difference
-    if (model.gameOver) {
-        int myScore = countBits(getPlayerBitboard(model.board, maximizingPlayer));
-        int oppScore = countBits(getOpponentBitboard(model.board, maximizingPlayer));
-
-        if (myScore > oppScore) return 10000;
-        if (myScore < oppScore) return -10000;
-        return 0;
+int NormalEvaluation::evaluate(const Board_t& board, PlayerColor_t player, NoTable::Key) const {
+    // Terminal position evaluation
+    if (isTerminal(board, player)) {
+        return evaluateFinal(board, player);
     }
 
-    int myPieces = countBits(getPlayerBitboard(model.board, maximizingPlayer));
-    int oppPieces = countBits(getOpponentBitboard(model.board, maximizingPlayer));
-
-    return myPieces - oppPieces;
+    // Simple evaluation: piece count difference
+    return getScoreDiff(board, player);
 }
 
-int AINormal::minimax(GameModel& model, int depth, bool isMaximizing, PlayerColor_t maximizingPlayer) const {
-    nodesExplored++;
-
-    // Check node limit
-    if (nodesExplored >= maxNodes) {
-        return evaluateBoard(model, maximizingPlayer);
-    }
-
-    if (depth == 0 || model.gameOver) {
-        return evaluateBoard(model, maximizingPlayer);
-    }
-
-    MoveList validMoves;
-    getValidMoves(model, validMoves);
-
-    if (validMoves.empty()) {
-        GameModel nextModel = copyModel(model);
-        nextModel.currentPlayer = getOpponent(nextModel.currentPlayer);
-
-        MoveList oppMoves;
-        getValidMoves(nextModel, oppMoves);
-
-        if (oppMoves.empty()) {
-            nextModel.gameOver = true;
-            return evaluateBoard(nextModel, maximizingPlayer);
-        }
-
-        return minimax(nextModel, depth - 1, !isMaximizing, maximizingPlayer);
-    }
-
-    if (isMaximizing) {
-        int maxEval = std::numeric_limits<int>::min();
+int NormalEvaluation::evaluateFinal(const Board_t& board, PlayerColor_t player) const {
+    int diff = getScoreDiff(board, player);
 
-        for (Move_t move : validMoves) {
-            if (nodesExplored >= maxNodes) break;  // Early exit
-
-            GameModel nextModel = copyModel(model);
-            playMove(nextModel, move);
-
-            int eval = minimax(nextModel, depth - 1, false, maximizingPlayer);
-            maxEval = std::max(maxEval, eval);
-        }
-
-        return maxEval;
-    }
-    else {
-        int minEval = std::numeric_limits<int>::max();
-
-        for (Move_t move : validMoves) {
-            if (nodesExplored >= maxNodes) break;  // Early exit
-
-            GameModel nextModel = copyModel(model);
-            playMove(nextModel, move);
-
-            int eval = minimax(nextModel, depth - 1, true, maximizingPlayer);
-            minEval = std::min(minEval, eval);
-        }
+    if (diff > 0) return 10000;
+    if (diff < 0) return -10000;
+    return 0;
+}
 
-        return minEval;
-    }
+AINormal::AINormal() : searchSeconds(0.0), maxNodes(DEFAULT_NODE_LIMIT) {
+    std::cout << "[AINormal] Initialized with node limit: " << maxNodes << std::endl;
 }
 
 Move_t AINormal::getBestMove(GameModel& model) {
-    nodesExplored = 0;
+    core.begin(maxNodes, &stopRequested);
+    searchSeconds = 0.0;
 
-    MoveList validMoves;
-    getValidMoves(model, validMoves);
+    PlayerColor_t currentPlayer = getCurrentPlayer(model);
+    int moveCount = getMoveCount(model.board, currentPlayer);
 
-    if (validMoves.empty()) {
+    if (moveCount == 0) {
         return MOVE_NONE;
     }
 
-    PlayerColor_t currentPlayer = getCurrentPlayer(model);
-    Move_t bestMove = validMoves[0];
-    int bestScore = std::numeric_limits<int>::min();
-
-    std::cout << "[AINormal] Evaluating " << validMoves.size()
+    std::cout << "[AINormal] Evaluating " << moveCount
         << " moves at depth " << MAX_DEPTH
         << " (node limit: " << maxNodes << ")..." << std::endl;
 
-    for (Move_t move : validMoves) {
-        if (nodesExplored >= maxNodes) {
-            break;
-        }
-
-        GameModel nextModel = copyModel(model);
-        playMove(nextModel, move);
-
-        int score = minimax(nextModel, MAX_DEPTH - 1, false, currentPlayer);
-
-        if (score > bestScore) {
-            bestScore = score;
-            bestMove = move;
-        }
-    }
+    auto startTime = std::chrono::steady_clock::now();
+    Move_t bestMove = core.searchRoot(model.board, currentPlayer, MAX_DEPTH);
+    searchSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
 
     return bestMove;
-}
\ No newline at end of file
+}
+
+void AINormal::getSearchStats(SearchStats& stats) const {
+    stats = SearchStats{};
+    stats.nodes = core.getNodes();
+    stats.nodesPerSecond = (searchSeconds > 0.0) ? stats.nodes / searchSeconds : 0.0;
+    stats.depth = MAX_DEPTH;
+    stats.selectiveDepth = core.getSelectiveDepth();
+    stats.elapsed = searchSeconds;
+    stats.evalCalls = core.getEvalCalls();
+}
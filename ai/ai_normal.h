@@ -14,6 +14,15 @@
 #define AI_NORMAL_H
 
 #include "ai_interface.h"
+#include "search_core.h"
+
+/**
+ * @brief Disc difference; wins and losses are worth +-10000
+ */
+struct NormalEvaluation : StaticEvaluation {
+    int evaluate(const Board_t& board, PlayerColor_t player, NoTable::Key) const;
+    int evaluateFinal(const Board_t& board, PlayerColor_t player) const;
+};
 
  /**
   * @brief Normal AI - Basic Minimax without pruning
@@ -24,12 +33,9 @@ private:
     static const int MAX_DEPTH = 4;
     static const int DEFAULT_NODE_LIMIT = 500000;  // Conservative limit for basic minimax
 
-    mutable int nodesExplored;
-    int maxNodes;  // Dynamic node limit
-
-    GameModel copyModel(const GameModel& model) const;
-    int evaluateBoard(const GameModel& model, PlayerColor_t maximizingPlayer) const;
-    int minimax(GameModel& model, int depth, bool isMaximizing, PlayerColor_t maximizingPlayer) const;
+    SearchCore<NormalEvaluation, NoOrdering, FullWidthPruning, NoTable, ImplicitPasses> core;
+    double searchSeconds;  // Duration of the last search
+    uint64_t maxNodes;     // Dynamic node limit
 
 public:
     AINormal();
@@ -38,16 +44,13 @@ public:
     virtual Move_t getBestMove(GameModel& model) override;
     virtual const char* getName() const override { return "Normal AI (Basic Minimax)"; }
 
-    virtual void getSearchStats(int& nodesSearched, int& maxDepth) const override {
-        nodesSearched = this->nodesExplored;
-        maxDepth = MAX_DEPTH;
-    }
+    virtual void getSearchStats(SearchStats& stats) const override;
 
-    virtual void setNodeLimit(int limit) override {
+    virtual void setNodeLimit(uint64_t limit) override {
         maxNodes = (limit > 0) ? limit : DEFAULT_NODE_LIMIT;
     }
 
-    virtual int getNodeLimit() const override {
+    virtual uint64_t getNodeLimit() const override {
         return maxNodes;
     }
 };
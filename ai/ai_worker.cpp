@@ -0,0 +1,141 @@
+/**
+ * @brief Persistent AI worker thread fed through a job queue
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "ai_worker.h"
+
+#include <iostream>
+
+// ============================================================================
+// Constructor / Destructor
+// ============================================================================
+
+AIWorker::AIWorker()
+    : activeAI(nullptr), jobRunning(false), nextJobId(1), shuttingDown(false) {
+    thread = std::thread(&AIWorker::run, this);
+}
+
+AIWorker::~AIWorker() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        shuttingDown = true;
+        jobs.clear();
+        if (activeAI) {
+            activeAI->stop();
+        }
+    }
+    queueCondition.notify_all();
+
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+// ============================================================================
+// Worker loop
+// ============================================================================
+
+void AIWorker::run() {
+    while (true) {
+        AIJob job;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return shuttingDown || !jobs.empty(); });
+
+            if (shuttingDown) {
+                return;
+            }
+
+            job = jobs.front();
+            jobs.pop_front();
+
+            // Cleared under the lock so a cancelAll() racing with this
+            // dequeue cannot have its stop() request erased
+            activeAI = job.ai;
+            jobRunning = true;
+            job.ai->clearStop();
+        }
+
+        std::cout << "[AI Worker] Job " << job.id << " using: " << job.ai->getName() << std::endl;
+
+        AIResult result;
+        result.jobId = job.id;
+        result.type = job.type;
+        result.move = MOVE_NONE;
+
+        if (job.type == AI_JOB_PONDER) {
+            job.ai->ponder(job.model);
+
+            std::cout << "[AI Worker] Job " << job.id << " ponder finished" << std::endl;
+        }
+        else {
+            result.move = job.ai->getBestMove(job.model);
+
+            std::cout << "[AI Worker] Job " << job.id << " found move: " << (int)result.move
+                      << std::endl;
+        }
+
+        // The render loop drains results every frame, so a full queue only
+        // lasts a frame or two
+        while (!results.push(result) && !shuttingDown) {
+            std::this_thread::yield();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            activeAI = nullptr;
+            jobRunning = false;
+        }
+        idleCondition.notify_all();
+    }
+}
+
+// ============================================================================
+// Main thread API
+// ============================================================================
+
+uint64_t AIWorker::submit(AIJobType type, AIInterface* ai, const GameModel& model) {
+    AIJob job;
+    job.id = nextJobId++;
+    job.type = type;
+    job.ai = ai;
+    job.model = model;
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        jobs.push_back(job);
+    }
+    queueCondition.notify_one();
+
+    return job.id;
+}
+
+bool AIWorker::pollResult(AIResult& result) {
+    return results.pop(result);
+}
+
+void AIWorker::cancelAll() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    jobs.clear();
+    if (activeAI) {
+        activeAI->stop();
+    }
+}
+
+void AIWorker::waitIdle() {
+    std::unique_lock<std::mutex> lock(queueMutex);
+    idleCondition.wait(lock, [this] { return jobs.empty() && !jobRunning; });
+}
+
+bool AIWorker::isBusy() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return !jobs.empty() || jobRunning;
+}
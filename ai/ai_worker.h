@@ -0,0 +1,129 @@
+/**
+ * @brief Persistent AI worker thread fed through a job queue
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef AI_WORKER_H
+#define AI_WORKER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "ai_interface.h"
+#include "spsc_queue.h"
+
+#define AI_RESULT_QUEUE_SIZE 16
+
+/**
+ * @brief Kinds of work the engine thread accepts
+ */
+enum AIJobType {
+    AI_JOB_SEARCH,  // Find the move to play in the given position
+    AI_JOB_PONDER   // Search on the opponent's time until cancelled
+};
+
+/**
+ * @brief A unit of work: the AI to run and a private copy of the game
+ */
+struct AIJob {
+    uint64_t id;
+    AIJobType type;
+    AIInterface* ai;
+    GameModel model;
+};
+
+/**
+ * @brief Result posted back to the render loop
+ */
+struct AIResult {
+    uint64_t jobId;
+    AIJobType type;
+    Move_t move;  // MOVE_NONE for ponder jobs
+};
+
+/**
+ * @brief Long-lived engine thread
+ *
+ * Jobs are submitted from the main thread through a mutex-protected queue
+ * (the worker sleeps on a condition variable while idle). Results come back
+ * through a lock-free SPSC queue that the render loop polls every frame.
+ * Cancelling never blocks: queued jobs are dropped and the running one is
+ * asked to stop(); its result still arrives and is matched by job id.
+ */
+class AIWorker {
+  private:
+    std::thread thread;
+
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;  // Signals new jobs / shutdown
+    std::condition_variable idleCondition;   // Signals end of a job
+    std::deque<AIJob> jobs;
+
+    AIInterface* activeAI;  // AI running the current job (guarded by queueMutex)
+    bool jobRunning;        // Guarded by queueMutex
+    uint64_t nextJobId;     // Main thread only
+    std::atomic<bool> shuttingDown;
+
+    SPSCQueue<AIResult, AI_RESULT_QUEUE_SIZE> results;
+
+    /**
+     * @brief Worker thread main loop
+     */
+    void run();
+
+  public:
+    AIWorker();
+    ~AIWorker();
+
+    AIWorker(const AIWorker&) = delete;
+    AIWorker& operator=(const AIWorker&) = delete;
+
+    /**
+     * @brief Queues a job (main thread only)
+     *
+     * The AI instance must stay alive until the worker is idle again.
+     *
+     * @param type Kind of job
+     * @param ai AI that will run it
+     * @param model Game state, copied into the job
+     * @return Job id, echoed in the matching AIResult
+     */
+    uint64_t submit(AIJobType type, AIInterface* ai, const GameModel& model);
+
+    /**
+     * @brief Fetches the next finished result without blocking (main thread only)
+     * @return True if a result was available
+     */
+    bool pollResult(AIResult& result);
+
+    /**
+     * @brief Drops queued jobs and asks the running one to stop (non-blocking)
+     */
+    void cancelAll();
+
+    /**
+     * @brief Blocks until no job is queued or running
+     *
+     * Returns within milliseconds after cancelAll(). Needed before the AI
+     * instance used by a job may be destroyed.
+     */
+    void waitIdle();
+
+    /**
+     * @brief Checks whether a job is queued or running
+     */
+    bool isBusy();
+};
+
+#endif // AI_WORKER_H
@@ -0,0 +1,108 @@
+/**
+ * @brief Direct-mapped cache of static evaluations
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef EVAL_CACHE_H
+#define EVAL_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+// ============================================================================
+// Evaluation Cache Configuration
+// ============================================================================
+
+#define EVAL_CACHE_BITS 16                      // 2^16 entries
+#define EVAL_CACHE_ENTRIES (1u << EVAL_CACHE_BITS)  // 512 KB, fits in L2
+
+/**
+ * @brief Zobrist hash -> evaluation score, one slot per index
+ *
+ * Each entry packs the upper 32 bits of the hash (the index already uses
+ * the low bits) with the 32-bit score into a single 64-bit word, so a
+ * probe never sees a key from one store and a score from another. Entries
+ * are relaxed atomics, so they cannot tear even if threads share them, but
+ * the probe/hit counters are plain integers: the cache as a whole is
+ * meant for one searching thread.
+ *
+ * The hash includes the side to move, so scores are kept from the side to
+ * move's point of view. Call clear() whenever the evaluation changes.
+ */
+class EvalCache {
+  private:
+    std::unique_ptr<std::atomic<uint64_t>[]> entries;
+
+    // Statistics
+    uint64_t probes;
+    uint64_t hits;
+
+    static uint64_t pack(uint64_t hash, int score) {
+        return (hash & 0xFFFFFFFF00000000ULL) | (uint32_t)score;
+    }
+
+  public:
+    EvalCache() : entries(new std::atomic<uint64_t>[EVAL_CACHE_ENTRIES]), probes(0), hits(0) {
+        clear();
+    }
+
+    void clear() {
+        for (uint32_t i = 0; i < EVAL_CACHE_ENTRIES; i++) {
+            entries[i].store(0, std::memory_order_relaxed);
+        }
+        resetStats();
+    }
+
+    void resetStats() {
+        probes = 0;
+        hits = 0;
+    }
+
+    /**
+     * @brief Looks up a position
+     * @return True if score was filled from the cache
+     */
+    bool probe(uint64_t hash, int& score) {
+        uint64_t entry = entries[hash & (EVAL_CACHE_ENTRIES - 1)].load(std::memory_order_relaxed);
+        probes++;
+
+        if (entry != 0 && ((entry ^ hash) & 0xFFFFFFFF00000000ULL) == 0) {
+            score = (int32_t)(uint32_t)entry;
+            hits++;
+            return true;
+        }
+        return false;
+    }
+
+    void store(uint64_t hash, int score) {
+        entries[hash & (EVAL_CACHE_ENTRIES - 1)].store(pack(hash, score),
+                                                      std::memory_order_relaxed);
+    }
+
+    uint64_t getProbes() const {
+        return probes;
+    }
+    uint64_t getHits() const {
+        return hits;
+    }
+    double getHitRate() const {
+        return probes > 0 ? (double)hits / probes : 0.0;
+    }
+
+    void printStats() const {
+        std::cout << "Eval cache: " << EVAL_CACHE_ENTRIES << " entries, " << probes
+                  << " probes, " << hits << " hits (" << (getHitRate() * 100.0) << "%)"
+                  << std::endl;
+    }
+};
+
+#endif // EVAL_CACHE_H
@@ -0,0 +1,313 @@
+/**
+ * @brief Small quantized neural network evaluator (NNUE-style)
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "nnue_eval.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// ============================================================================
+// Vector Kernels
+// ============================================================================
+
+/**
+ * @brief values += row
+ */
+inline void addRow(int16_t* values, const int16_t* row) {
+#ifdef __AVX2__
+    for (int i = 0; i < NNUE_HIDDEN1; i += 16) {
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i r = _mm256_load_si256(reinterpret_cast<const __m256i*>(row + i));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(values + i), _mm256_add_epi16(v, r));
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN1; i++) {
+        values[i] += row[i];
+    }
+#endif
+}
+
+/**
+ * @brief values -= row
+ */
+inline void subRow(int16_t* values, const int16_t* row) {
+#ifdef __AVX2__
+    for (int i = 0; i < NNUE_HIDDEN1; i += 16) {
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i r = _mm256_load_si256(reinterpret_cast<const __m256i*>(row + i));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(values + i), _mm256_sub_epi16(v, r));
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN1; i++) {
+        values[i] -= row[i];
+    }
+#endif
+}
+
+/**
+ * @brief values += added - removed (a disc changing colour)
+ */
+inline void addSubRow(int16_t* values, const int16_t* added, const int16_t* removed) {
+#ifdef __AVX2__
+    for (int i = 0; i < NNUE_HIDDEN1; i += 16) {
+        __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(added + i));
+        __m256i r = _mm256_load_si256(reinterpret_cast<const __m256i*>(removed + i));
+        v = _mm256_sub_epi16(_mm256_add_epi16(v, a), r);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(values + i), v);
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN1; i++) {
+        values[i] += added[i] - removed[i];
+    }
+#endif
+}
+
+/**
+ * @brief Clipped ReLU of the accumulator into 0..NNUE_SCALE_ACTIVATION
+ */
+inline void clampActivations(const int16_t* values, uint8_t* activations) {
+#ifdef __AVX2__
+    const __m256i limit = _mm256_set1_epi8(NNUE_SCALE_ACTIVATION);
+    for (int i = 0; i < NNUE_HIDDEN1; i += 32) {
+        __m256i low = _mm256_load_si256(reinterpret_cast<const __m256i*>(values + i));
+        __m256i high = _mm256_load_si256(reinterpret_cast<const __m256i*>(values + i + 16));
+        // packus works per 128-bit lane; the permute restores element order
+        __m256i packed = _mm256_min_epu8(_mm256_packus_epi16(low, high), limit);
+        packed = _mm256_permute4x64_epi64(packed, 0xD8);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(activations + i), packed);
+    }
+#else
+    for (int i = 0; i < NNUE_HIDDEN1; i++) {
+        activations[i] = (uint8_t)std::clamp((int)values[i], 0, NNUE_SCALE_ACTIVATION);
+    }
+#endif
+}
+
+/**
+ * @brief Dot product of uint8 activations and int8 weights
+ *
+ * Pairwise products stay below 2 * 127 * 127, so the 16-bit intermediate
+ * sums of the AVX2 path never saturate.
+ */
+inline int dotActivations(const uint8_t* activations, const int8_t* weights) {
+#ifdef __AVX2__
+    const __m256i ones = _mm256_set1_epi16(1);
+    __m256i sum = _mm256_setzero_si256();
+    for (int i = 0; i < NNUE_HIDDEN1; i += 32) {
+        __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i*>(activations + i));
+        __m256i w = _mm256_load_si256(reinterpret_cast<const __m256i*>(weights + i));
+        sum = _mm256_add_epi32(sum, _mm256_madd_epi16(_mm256_maddubs_epi16(a, w), ones));
+    }
+    __m128i total = _mm_add_epi32(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+    total = _mm_add_epi32(total, _mm_shuffle_epi32(total, 0x4E));
+    total = _mm_add_epi32(total, _mm_shuffle_epi32(total, 0xB1));
+    return _mm_cvtsi128_si32(total);
+#else
+    int sum = 0;
+    for (int i = 0; i < NNUE_HIDDEN1; i++) {
+        sum += activations[i] * weights[i];
+    }
+    return sum;
+#endif
+}
+
+/**
+ * @brief Rounds and saturates a scaled float weight
+ */
+template <typename T>
+T quantize(float value, float scale, long long limit) {
+    long long q = std::llround((double)value * scale);
+    return (T)std::clamp(q, -limit, limit);
+}
+
+} // namespace
+
+// ============================================================================
+// Constructor / Loading
+// ============================================================================
+
+NeuralEvaluator::NeuralEvaluator() : loaded(false) {
+    memset(inputWeights, 0, sizeof(inputWeights));
+    memset(inputBias, 0, sizeof(inputBias));
+    memset(hiddenWeights, 0, sizeof(hiddenWeights));
+    memset(hiddenBias, 0, sizeof(hiddenBias));
+    memset(outputWeights, 0, sizeof(outputWeights));
+    memset(outputBias, 0, sizeof(outputBias));
+}
+
+bool NeuralEvaluator::load(const std::string& filename) {
+    loaded = false;
+
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    uint32_t header[6];
+    bool valid = fread(header, sizeof(header), 1, file) == 1 && header[0] == NNUE_FILE_MAGIC &&
+        header[1] == NNUE_FILE_VERSION && header[2] == NNUE_INPUTS &&
+        header[3] == NNUE_HIDDEN1 && header[4] == NNUE_HIDDEN2 && header[5] == NNUE_BUCKETS;
+
+    valid = valid && fread(inputWeights, sizeof(inputWeights), 1, file) == 1 &&
+        fread(inputBias, sizeof(inputBias), 1, file) == 1 &&
+        fread(hiddenWeights, sizeof(hiddenWeights), 1, file) == 1 &&
+        fread(hiddenBias, sizeof(hiddenBias), 1, file) == 1 &&
+        fread(outputWeights, sizeof(outputWeights), 1, file) == 1 &&
+        fread(outputBias, sizeof(outputBias), 1, file) == 1;
+
+    fclose(file);
+
+    if (!valid) {
+        std::cerr << "Network in " << filename << " does not match this build" << std::endl;
+    }
+
+    loaded = valid;
+    return loaded;
+}
+
+bool NeuralEvaluator::save(const std::string& filename, const NeuralNetwork& network) {
+    std::unique_ptr<NeuralEvaluator> q = std::make_unique<NeuralEvaluator>();
+    const float activationScale = NNUE_SCALE_ACTIVATION;
+
+    for (int i = 0; i < NNUE_INPUTS; i++) {
+        for (int j = 0; j < NNUE_HIDDEN1; j++) {
+            q->inputWeights[i][j] =
+                quantize<int16_t>(network.inputWeights[i][j], activationScale, INT16_MAX);
+        }
+    }
+    for (int j = 0; j < NNUE_HIDDEN1; j++) {
+        q->inputBias[j] = quantize<int16_t>(network.inputBias[j], activationScale, INT16_MAX);
+    }
+
+    for (int b = 0; b < NNUE_BUCKETS; b++) {
+        for (int o = 0; o < NNUE_HIDDEN2; o++) {
+            for (int j = 0; j < NNUE_HIDDEN1; j++) {
+                q->hiddenWeights[b][o][j] =
+                    quantize<int8_t>(network.hiddenWeights[b][o][j], NNUE_SCALE_HIDDEN, 127);
+            }
+            q->hiddenBias[b][o] = quantize<int32_t>(network.hiddenBias[b][o],
+                activationScale * NNUE_SCALE_HIDDEN, INT32_MAX);
+            q->outputWeights[b][o] =
+                quantize<int16_t>(network.outputWeights[b][o], NNUE_SCALE_OUTPUT, INT16_MAX);
+        }
+        q->outputBias[b] = quantize<int32_t>(network.outputBias[b],
+            activationScale * NNUE_SCALE_OUTPUT, INT32_MAX);
+    }
+
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    uint32_t header[6] = { NNUE_FILE_MAGIC, NNUE_FILE_VERSION, NNUE_INPUTS, NNUE_HIDDEN1,
+                           NNUE_HIDDEN2, NNUE_BUCKETS };
+
+    bool ok = fwrite(header, sizeof(header), 1, file) == 1 &&
+        fwrite(q->inputWeights, sizeof(q->inputWeights), 1, file) == 1 &&
+        fwrite(q->inputBias, sizeof(q->inputBias), 1, file) == 1 &&
+        fwrite(q->hiddenWeights, sizeof(q->hiddenWeights), 1, file) == 1 &&
+        fwrite(q->hiddenBias, sizeof(q->hiddenBias), 1, file) == 1 &&
+        fwrite(q->outputWeights, sizeof(q->outputWeights), 1, file) == 1 &&
+        fwrite(q->outputBias, sizeof(q->outputBias), 1, file) == 1;
+
+    return (fclose(file) == 0) && ok;
+}
+
+const char* NeuralEvaluator::getInstructionSet() {
+#ifdef __AVX2__
+    return "AVX2";
+#else
+    return "scalar";
+#endif
+}
+
+// ============================================================================
+// Accumulator
+// ============================================================================
+
+void NeuralEvaluator::refresh(NeuralAccumulator& accumulator, const Board_t& board) const {
+    memcpy(accumulator.values, inputBias, sizeof(inputBias));
+
+    for (uint64_t discs = board.black; discs; discs &= discs - 1) {
+        addRow(accumulator.values, inputWeights[bitScanForward(discs)]);
+    }
+    for (uint64_t discs = board.white; discs; discs &= discs - 1) {
+        addRow(accumulator.values, inputWeights[64 + bitScanForward(discs)]);
+    }
+}
+
+void NeuralEvaluator::play(NeuralAccumulator& accumulator,
+    Move_t move,
+    uint64_t flips,
+    PlayerColor_t player) const {
+    int own = (player == PLAYER_BLACK) ? 0 : 64;
+    int other = 64 - own;
+
+    addRow(accumulator.values, inputWeights[own + move]);
+
+    for (; flips; flips &= flips - 1) {
+        Move_t square = bitScanForward(flips);
+        addSubRow(accumulator.values, inputWeights[own + square], inputWeights[other + square]);
+    }
+}
+
+void NeuralEvaluator::undo(NeuralAccumulator& accumulator,
+    Move_t move,
+    uint64_t flips,
+    PlayerColor_t player) const {
+    int own = (player == PLAYER_BLACK) ? 0 : 64;
+    int other = 64 - own;
+
+    subRow(accumulator.values, inputWeights[own + move]);
+
+    for (; flips; flips &= flips - 1) {
+        Move_t square = bitScanForward(flips);
+        addSubRow(accumulator.values, inputWeights[other + square], inputWeights[own + square]);
+    }
+}
+
+// ============================================================================
+// Inference
+// ============================================================================
+
+int NeuralEvaluator::evaluate(const NeuralAccumulator& accumulator,
+    PlayerColor_t player,
+    int emptyCount) const {
+    int bucket = getBucket(emptyCount);
+
+    alignas(32) uint8_t hidden1[NNUE_HIDDEN1];
+    clampActivations(accumulator.values, hidden1);
+
+    int64_t output = outputBias[bucket];
+    for (int o = 0; o < NNUE_HIDDEN2; o++) {
+        int sum = hiddenBias[bucket][o] + dotActivations(hidden1, hiddenWeights[bucket][o]);
+        int hidden2 = std::clamp(sum / NNUE_SCALE_HIDDEN, 0, NNUE_SCALE_ACTIVATION);
+        output += hidden2 * outputWeights[bucket][o];
+    }
+
+    // Raw output of 1.0 is NNUE_SCALE_ACTIVATION * NNUE_SCALE_OUTPUT
+    int score = (int)(output * (NNUE_OUTPUT_DISCS * NNUE_SCORE_PER_DISC) /
+        (NNUE_SCALE_ACTIVATION * NNUE_SCALE_OUTPUT));
+
+    return (player == PLAYER_BLACK) ? score : -score;
+}
@@ -0,0 +1,144 @@
+/**
+ * @brief Small quantized neural network evaluator (NNUE-style)
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef NNUE_EVAL_H
+#define NNUE_EVAL_H
+
+#include <cstdint>
+#include <string>
+
+#include "../model.h"
+
+// ============================================================================
+// Network Configuration
+// ============================================================================
+
+#define NNUE_WEIGHTS_FILE "eval_nnue.bin"  // Looked up next to the WTH files
+#define NNUE_FILE_MAGIC 0x4E4E4445          // "EDNN", little-endian
+#define NNUE_FILE_VERSION 1
+
+#define NNUE_INPUTS 128   // Black discs (squares 0-63), then white discs
+#define NNUE_HIDDEN1 64   // Accumulator width
+#define NNUE_HIDDEN2 32
+#define NNUE_BUCKETS 4    // Layer 2 and output sets, 16 empties each
+
+// Quantization: a float activation of 1.0 is stored as NNUE_SCALE_ACTIVATION
+#define NNUE_SCALE_ACTIVATION 127
+#define NNUE_SCALE_HIDDEN 64     // Layer 2 weights (int8)
+#define NNUE_SCALE_OUTPUT 1024   // Output weights (int16)
+
+// Float weight ranges that survive quantization (the accumulator sums at
+// most 65 input weights and biases without overflowing int16)
+#define NNUE_INPUT_WEIGHT_LIMIT 3.9f
+#define NNUE_HIDDEN_WEIGHT_LIMIT (127.0f / NNUE_SCALE_HIDDEN)
+#define NNUE_OUTPUT_WEIGHT_LIMIT (32767.0f / NNUE_SCALE_OUTPUT)
+
+#define NNUE_OUTPUT_DISCS 64     // Final margin represented by a raw output of 1.0
+#define NNUE_SCORE_PER_DISC 16   // Evaluation units per disc (as the patterns)
+
+/**
+ * @brief Float network, as trained (black's point of view)
+ *
+ * h1 = clamp(b1 + sum of W1 rows of the occupied inputs, 0, 1)
+ * h2 = clamp(b2 + W2 h1, 0, 1)
+ * output = b3 + W3 h2, in units of NNUE_OUTPUT_DISCS
+ *
+ * Layer 2 and the output use the set of the position's bucket.
+ */
+struct NeuralNetwork {
+    float inputWeights[NNUE_INPUTS][NNUE_HIDDEN1];
+    float inputBias[NNUE_HIDDEN1];
+    float hiddenWeights[NNUE_BUCKETS][NNUE_HIDDEN2][NNUE_HIDDEN1];
+    float hiddenBias[NNUE_BUCKETS][NNUE_HIDDEN2];
+    float outputWeights[NNUE_BUCKETS][NNUE_HIDDEN2];
+    float outputBias[NNUE_BUCKETS];
+};
+
+/**
+ * @brief First layer output for one position, kept up to date move by move
+ */
+struct NeuralAccumulator {
+    alignas(32) int16_t values[NNUE_HIDDEN1];
+};
+
+/**
+ * @brief Integer inference of a NeuralNetwork
+ *
+ * The first layer is never recomputed during search: play() adds the
+ * weight rows of the placed disc and moves each flipped disc's row from
+ * one colour to the other, and undo() reverses it. Evaluating runs only
+ * the two small layers on top, with int8 weights for layer 2.
+ *
+ * Built with AVX2 (-mavx2 or /arch:AVX2) the row updates and the layer 2
+ * dot products use 256-bit integer instructions; otherwise the same
+ * arithmetic runs as scalar loops, with identical results.
+ */
+class NeuralEvaluator {
+  private:
+    alignas(32) int16_t inputWeights[NNUE_INPUTS][NNUE_HIDDEN1];
+    alignas(32) int16_t inputBias[NNUE_HIDDEN1];
+    alignas(32) int8_t hiddenWeights[NNUE_BUCKETS][NNUE_HIDDEN2][NNUE_HIDDEN1];
+    int32_t hiddenBias[NNUE_BUCKETS][NNUE_HIDDEN2];
+    int16_t outputWeights[NNUE_BUCKETS][NNUE_HIDDEN2];
+    int32_t outputBias[NNUE_BUCKETS];
+    bool loaded;
+
+  public:
+    NeuralEvaluator();
+
+    /**
+     * @brief Loads a network written by save()
+     * @return True if the file matched this build's network shape
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Quantizes a trained network and writes it
+     */
+    static bool save(const std::string& filename, const NeuralNetwork& network);
+
+    bool isLoaded() const {
+        return loaded;
+    }
+
+    /**
+     * @brief Computes the accumulator from scratch (search root)
+     */
+    void refresh(NeuralAccumulator& accumulator, const Board_t& board) const;
+
+    /**
+     * @brief Applies a move: the square becomes player's, flips change sides
+     */
+    void play(NeuralAccumulator& accumulator, Move_t move, uint64_t flips,
+              PlayerColor_t player) const;
+
+    /**
+     * @brief Reverts play() with the same arguments
+     */
+    void undo(NeuralAccumulator& accumulator, Move_t move, uint64_t flips,
+              PlayerColor_t player) const;
+
+    /**
+     * @brief Scores the position for the side to move
+     */
+    int evaluate(const NeuralAccumulator& accumulator, PlayerColor_t player,
+                 int emptyCount) const;
+
+    static int getBucket(int emptyCount) {
+        int bucket = (emptyCount - 1) / 16;
+        return (bucket < 0) ? 0 : (bucket >= NNUE_BUCKETS ? NNUE_BUCKETS - 1 : bucket);
+    }
+
+    static const char* getInstructionSet();
+};
+
+#endif // NNUE_EVAL_H
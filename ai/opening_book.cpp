@@ -15,10 +15,11 @@
 #include <algorithm>
 #include <cstring>
 #include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <random>
 
+#include "wthor_database.h"
+
 namespace fs = std::filesystem;
 
 // ============================================================================
@@ -29,32 +30,6 @@ OpeningBook::OpeningBook(TranspositionTable* transpositionTable)
     : tt(transpositionTable), totalGamesLoaded(0), totalPositions(0), maxDepthStored(0) {
 }
 
-// ============================================================================
-// WThor Move Decoding
-// ============================================================================
-
-Move_t OpeningBook::decodeWThorMove(uint8_t wthorMove) const {
-    if (wthorMove == 0)
-        return MOVE_NONE;  // No move (game ended)
-
-    // WThor encoding: position = (row+1)*10 + (col+1)
-    // Examples:
-    //   A1 = 11, H1 = 18
-    //   A8 = 81, H8 = 88
-    //   D4 = 44, E4 = 54
-
-    int row = (wthorMove / 10) - 1;  // Get row (0-7)
-    int col = (wthorMove % 10) - 1;  // Get col (0-7)
-
-    // Validate
-    if (row < 0 || row >= 8 || col < 0 || col >= 8) {
-        return MOVE_NONE;
-    }
-
-    // Convert to our format: row * 8 + col
-    return coordsToMove(col, row);
-}
-
 // ============================================================================
 // Game Loading
 // ============================================================================
@@ -149,57 +124,20 @@ void OpeningBook::addGame(const std::vector<Move_t>& moves, int blackScore) {
 }
 
 int OpeningBook::loadWTBFile(const std::string& filename) {
-    std::ifstream file(filename, std::ios::binary);
-    if (!file) {
-        std::cerr << "Failed to open book file: " << filename << std::endl;
-        return 0;
-    }
+    std::cout << "Loading games from " << filename << "..." << std::endl;
 
-    // Read header (16 bytes)
-    uint8_t header[16];
-    file.read(reinterpret_cast<char*>(header), 16);
-
-    if (!file) {
-        std::cerr << "Failed to read header from: " << filename << std::endl;
-        return 0;
-    }
-
-    // Extract game count (bytes 4-7, little-endian)
-    int gameCount = header[4] | (header[5] << 8) | (header[6] << 16) | (header[7] << 24);
-
-    std::cout << "Loading " << gameCount << " games from " << filename << "..." << std::endl;
+    std::vector<WThorGame> games;
+    readWThorFile(filename, games);
 
     int gamesLoaded = 0;
-
-    // Read each game (68 bytes per game)
-    for (int g = 0; g < gameCount; g++) {
-        uint8_t gameData[68];
-        file.read(reinterpret_cast<char*>(gameData), 68);
-
-        if (!file)
-            break;
-
-        // Extract moves (bytes 8-67, 60 moves max)
-        std::vector<Move_t> moves;
-        for (int i = 8; i < 68; i++) {
-            Move_t move = decodeWThorMove(gameData[i]);
-            if (move == MOVE_NONE)
-                break;
-            moves.push_back(move);
-        }
-
-        // Extract theoretical score (byte 7)
-        int blackScore = gameData[7];
-
-        // Validate score
-        if (blackScore >= 0 && blackScore <= 64 && !moves.empty()) {
-            addGame(moves, blackScore);
+    for (const WThorGame& game : games) {
+        // Theoretical score: perfect play from the recorded depth
+        if (game.theoreticalScore <= 64) {
+            addGame(game.moves, game.theoreticalScore);
             gamesLoaded++;
         }
     }
 
-    file.close();
-
     std::cout << "Loaded " << gamesLoaded << " games successfully." << std::endl;
 
     return gamesLoaded;
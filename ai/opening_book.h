@@ -94,17 +94,6 @@ class OpeningBook {
     // Zobrist hashing (same as TT for consistency)
     TranspositionTable* tt;
 
-    /**
-     * @brief Converts WThor move encoding to our Move_t format
-     *
-     * WThor format: (row * 10 + col + 10)
-     * Our format: (row * 8 + col)
-     *
-     * @param wthorMove WThor encoded move
-     * @return Move_t (0-63), or MOVE_NONE if invalid
-     */
-    Move_t decodeWThorMove(uint8_t wthorMove) const;
-
     /**
      * @brief Parses a single .wtb file
      *
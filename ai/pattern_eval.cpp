@@ -0,0 +1,301 @@
+/**
+ * @brief Pattern-based evaluation with incrementally updated indices
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "pattern_eval.h"
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+
+// ============================================================================
+// Pattern Set
+// ============================================================================
+
+int PatternEvaluator::instanceCount = 0;
+uint32_t PatternEvaluator::instanceOffset[64];
+size_t PatternEvaluator::phaseSize = 0;
+
+namespace {
+
+/**
+ * @brief Squares of one shape in its base placement, as (x, y) pairs
+ */
+struct ShapeDefinition {
+    PatternShape shape;
+    int size;
+    int8_t coords[10][2];
+};
+
+const ShapeDefinition shapeDefinitions[PATTERN_SHAPE_COUNT] = {
+    { PATTERN_EDGE_2X, 10,
+      { {1, 1}, {0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0}, {5, 0}, {6, 0}, {7, 0}, {6, 1} } },
+    { PATTERN_CORNER_3X3, 9,
+      { {0, 0}, {1, 0}, {2, 0}, {0, 1}, {1, 1}, {2, 1}, {0, 2}, {1, 2}, {2, 2} } },
+    { PATTERN_CORNER_2X5, 10,
+      { {0, 0}, {1, 0}, {2, 0}, {3, 0}, {4, 0}, {0, 1}, {1, 1}, {2, 1}, {3, 1}, {4, 1} } },
+    { PATTERN_LINE_2, 8, { {0, 1}, {1, 1}, {2, 1}, {3, 1}, {4, 1}, {5, 1}, {6, 1}, {7, 1} } },
+    { PATTERN_LINE_3, 8, { {0, 2}, {1, 2}, {2, 2}, {3, 2}, {4, 2}, {5, 2}, {6, 2}, {7, 2} } },
+    { PATTERN_LINE_4, 8, { {0, 3}, {1, 3}, {2, 3}, {3, 3}, {4, 3}, {5, 3}, {6, 3}, {7, 3} } },
+    { PATTERN_DIAG_8, 8, { {0, 0}, {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}, {6, 6}, {7, 7} } },
+    { PATTERN_DIAG_7, 7, { {1, 0}, {2, 1}, {3, 2}, {4, 3}, {5, 4}, {6, 5}, {7, 6} } },
+    { PATTERN_DIAG_6, 6, { {2, 0}, {3, 1}, {4, 2}, {5, 3}, {6, 4}, {7, 5} } },
+    { PATTERN_DIAG_5, 5, { {3, 0}, {4, 1}, {5, 2}, {6, 3}, {7, 4} } },
+    { PATTERN_DIAG_4, 4, { {4, 0}, {5, 1}, {6, 2}, {7, 3} } },
+};
+
+/**
+ * @brief Pattern instances touching a square, with the square's digit weight
+ */
+struct SquareFeature {
+    uint8_t instance;
+    uint16_t power;
+};
+
+std::vector<PatternInstance> instances;
+size_t shapeOffsets[PATTERN_SHAPE_COUNT];
+SquareFeature squareFeatures[64][PATTERN_MAX_PER_SQUARE];
+int squareFeatureCount[64];
+
+/**
+ * @brief Applies one of the 8 board symmetries to a coordinate
+ */
+Move_t transformSquare(int x, int y, int symmetry) {
+    if (symmetry & 1)
+        x = 7 - x;
+    if (symmetry & 2)
+        y = 7 - y;
+    if (symmetry & 4) {
+        int t = x;
+        x = y;
+        y = t;
+    }
+    return coordsToMove(x, y);
+}
+
+/**
+ * @brief Builds every distinct placement of every shape and the square map
+ */
+struct PatternSetBuilder {
+    PatternSetBuilder() {
+        size_t offset = 0;
+
+        for (const ShapeDefinition& def : shapeDefinitions) {
+            shapeOffsets[def.shape] = offset;
+
+            int power = 1;
+            for (int i = 0; i < def.size; i++) {
+                power *= 3;
+            }
+            offset += power;
+
+            // Symmetric images covering the same squares are the same instance
+            std::vector<uint64_t> seen;
+            for (int symmetry = 0; symmetry < 8; symmetry++) {
+                PatternInstance instance;
+                instance.shape = def.shape;
+                uint64_t mask = 0;
+
+                for (int i = 0; i < def.size; i++) {
+                    Move_t square = transformSquare(def.coords[i][0], def.coords[i][1], symmetry);
+                    instance.squares.push_back(square);
+                    mask |= 1ULL << square;
+                }
+
+                bool duplicate = false;
+                for (uint64_t other : seen) {
+                    duplicate |= (other == mask);
+                }
+                if (!duplicate) {
+                    seen.push_back(mask);
+                    instances.push_back(instance);
+                }
+            }
+        }
+
+        PatternEvaluator::registerPatternSet((int)instances.size(), offset);
+    }
+};
+
+} // namespace
+
+void PatternEvaluator::registerPatternSet(int count, size_t weightsPerPhase) {
+    instanceCount = count;
+    phaseSize = weightsPerPhase;
+
+    for (int i = 0; i < 64; i++) {
+        squareFeatureCount[i] = 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const PatternInstance& instance = instances[i];
+        instanceOffset[i] = (uint32_t)shapeOffsets[instance.shape];
+
+        uint16_t power = 1;
+        for (Move_t square : instance.squares) {
+            // The X-squares already reach the limit with the built-in set
+            assert(squareFeatureCount[square] < PATTERN_MAX_PER_SQUARE);
+            SquareFeature& feature = squareFeatures[square][squareFeatureCount[square]++];
+            feature.instance = (uint8_t)i;
+            feature.power = power;
+            power *= 3;
+        }
+    }
+}
+
+static PatternSetBuilder patternSetBuilder;
+
+int PatternEvaluator::getInstanceCount() {
+    return instanceCount;
+}
+
+const PatternInstance& PatternEvaluator::getInstance(int instance) {
+    return instances[instance];
+}
+
+int PatternEvaluator::getShapeSize(PatternShape shape) {
+    return shapeDefinitions[shape].size;
+}
+
+size_t PatternEvaluator::getShapeOffset(PatternShape shape) {
+    return shapeOffsets[shape];
+}
+
+size_t PatternEvaluator::getWeightsPerPhase() {
+    return phaseSize;
+}
+
+// ============================================================================
+// Constructor / Loading
+// ============================================================================
+
+PatternEvaluator::PatternEvaluator() : loaded(false) {
+}
+
+bool PatternEvaluator::load(const std::string& filename) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file) {
+        weights.clear();
+        loaded = false;
+        return false;
+    }
+
+    uint32_t header[4];
+    uint32_t sizes[PATTERN_SHAPE_COUNT];
+    bool valid = fread(header, sizeof(header), 1, file) == 1 &&
+        header[0] == PATTERN_FILE_MAGIC && header[1] == PATTERN_FILE_VERSION &&
+        header[2] == PATTERN_PHASES && header[3] == PATTERN_SHAPE_COUNT &&
+        fread(sizes, sizeof(sizes), 1, file) == 1;
+
+    for (int shape = 0; valid && shape < PATTERN_SHAPE_COUNT; shape++) {
+        valid = (sizes[shape] == (uint32_t)shapeDefinitions[shape].size);
+    }
+
+    if (valid) {
+        weights.resize(PATTERN_PHASES * phaseSize);
+        valid = fread(weights.data(), sizeof(int16_t), weights.size(), file) == weights.size();
+    }
+
+    fclose(file);
+
+    if (!valid) {
+        std::cerr << "Pattern weights in " << filename << " do not match this build" << std::endl;
+        weights.clear();
+    }
+
+    loaded = valid;
+    return loaded;
+}
+
+bool PatternEvaluator::save(const std::string& filename, const std::vector<int16_t>& weights) {
+    if (weights.size() != PATTERN_PHASES * phaseSize) {
+        return false;
+    }
+
+    FILE* file = fopen(filename.c_str(), "wb");
+    if (!file) {
+        return false;
+    }
+
+    uint32_t header[4] = { PATTERN_FILE_MAGIC, PATTERN_FILE_VERSION, PATTERN_PHASES,
+                           PATTERN_SHAPE_COUNT };
+    uint32_t sizes[PATTERN_SHAPE_COUNT];
+    for (int shape = 0; shape < PATTERN_SHAPE_COUNT; shape++) {
+        sizes[shape] = shapeDefinitions[shape].size;
+    }
+
+    bool ok = fwrite(header, sizeof(header), 1, file) == 1 &&
+        fwrite(sizes, sizeof(sizes), 1, file) == 1 &&
+        fwrite(weights.data(), sizeof(int16_t), weights.size(), file) == weights.size();
+
+    return (fclose(file) == 0) && ok;
+}
+
+// ============================================================================
+// Index Maintenance
+// ============================================================================
+
+void PatternEvaluator::setBoard(PatternState& state, const Board_t& board) {
+    for (int i = 0; i < instanceCount; i++) {
+        const std::vector<Move_t>& squares = instances[i].squares;
+        int index = 0;
+
+        // Most significant digit is the last square
+        for (int j = (int)squares.size() - 1; j >= 0; j--) {
+            uint64_t bit = 1ULL << squares[j];
+            index = index * 3 + ((board.black & bit) ? 1 : ((board.white & bit) ? 2 : 0));
+        }
+
+        state.index[i] = (uint16_t)index;
+    }
+}
+
+void PatternEvaluator::play(PatternState& state, Move_t move, uint64_t flips, PlayerColor_t player) {
+    // Empty -> black adds 1 digit, empty -> white adds 2
+    int placed = (player == PLAYER_BLACK) ? 1 : 2;
+    // White -> black removes 1 digit, black -> white adds 1
+    int flipped = (player == PLAYER_BLACK) ? -1 : 1;
+
+    for (int f = 0; f < squareFeatureCount[move]; f++) {
+        const SquareFeature& feature = squareFeatures[move][f];
+        state.index[feature.instance] += placed * feature.power;
+    }
+
+    while (flips) {
+        Move_t square = bitScanForward(flips);
+        flips &= flips - 1;
+
+        for (int f = 0; f < squareFeatureCount[square]; f++) {
+            const SquareFeature& feature = squareFeatures[square][f];
+            state.index[feature.instance] += flipped * feature.power;
+        }
+    }
+}
+
+void PatternEvaluator::undo(PatternState& state, Move_t move, uint64_t flips, PlayerColor_t player) {
+    int placed = (player == PLAYER_BLACK) ? 1 : 2;
+    int flipped = (player == PLAYER_BLACK) ? -1 : 1;
+
+    for (int f = 0; f < squareFeatureCount[move]; f++) {
+        const SquareFeature& feature = squareFeatures[move][f];
+        state.index[feature.instance] -= placed * feature.power;
+    }
+
+    while (flips) {
+        Move_t square = bitScanForward(flips);
+        flips &= flips - 1;
+
+        for (int f = 0; f < squareFeatureCount[square]; f++) {
+            const SquareFeature& feature = squareFeatures[square][f];
+            state.index[feature.instance] -= flipped * feature.power;
+        }
+    }
+}
@@ -0,0 +1,160 @@
+/**
+ * @brief Pattern-based evaluation with incrementally updated indices
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef PATTERN_EVAL_H
+#define PATTERN_EVAL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../model.h"
+
+// ============================================================================
+// Pattern Evaluation Configuration
+// ============================================================================
+
+#define PATTERN_WEIGHTS_FILE "eval_patterns.bin"  // Looked up next to the WTH files
+#define PATTERN_FILE_MAGIC 0x57504445              // "EDPW", little-endian
+#define PATTERN_FILE_VERSION 1
+
+#define PATTERN_PHASES 15            // Weight sets, 4 empties each
+#define PATTERN_SCORE_PER_DISC 16    // Evaluation units per disc of final margin
+#define PATTERN_MAX_PER_SQUARE 8     // Upper bound on instances touching a square
+
+/**
+ * @brief Pattern shapes (each evaluated on all its symmetric placements)
+ */
+enum PatternShape {
+    PATTERN_EDGE_2X,      // A1-H1 plus B2, G2
+    PATTERN_CORNER_3X3,   // A1-C3
+    PATTERN_CORNER_2X5,   // A1-E2
+    PATTERN_LINE_2,       // A2-H2
+    PATTERN_LINE_3,       // A3-H3
+    PATTERN_LINE_4,       // A4-H4
+    PATTERN_DIAG_8,       // A1-H8
+    PATTERN_DIAG_7,       // B1-H7
+    PATTERN_DIAG_6,       // C1-H6
+    PATTERN_DIAG_5,       // D1-H5
+    PATTERN_DIAG_4,       // E1-H4
+    PATTERN_SHAPE_COUNT
+};
+
+/**
+ * @brief One placement of a shape on the board
+ */
+struct PatternInstance {
+    PatternShape shape;
+    std::vector<Move_t> squares;  // Digit i of the index is squares[i]
+};
+
+/**
+ * @brief Base-3 index of every pattern instance for one position
+ *
+ * Digit per square: 0 = empty, 1 = black, 2 = white.
+ */
+struct PatternState {
+    uint16_t index[64];  // Only the first getInstanceCount() are used
+};
+
+/**
+ * @brief Logistello/Edax-style evaluator
+ *
+ * The score is the sum of one weight per pattern instance, looked up by its
+ * base-3 index in the table of the current game phase. Indices are kept up
+ * to date from the move delta (square + flips), so evaluating costs one
+ * table lookup per instance.
+ *
+ * Weight file layout (little-endian): magic, version, phase count, shape
+ * count, squares per shape, then int16 weights for each phase and shape
+ * (3^squares entries each), in evaluation units from black's point of view.
+ */
+class PatternEvaluator {
+  private:
+    std::vector<int16_t> weights;  // [phase][shape offset + index]
+    bool loaded;
+
+    // Filled once at startup from the shape definitions
+    static int instanceCount;
+    static uint32_t instanceOffset[64];  // Offset of each instance's shape table
+    static size_t phaseSize;             // Weights per phase
+
+  public:
+    PatternEvaluator();
+
+    /**
+     * @brief Installs the pattern set (called once by pattern_eval.cpp at startup)
+     */
+    static void registerPatternSet(int count, size_t weightsPerPhase);
+
+    /**
+     * @brief Loads weights written by the trainer
+     * @return True if the file matched this build's pattern set
+     */
+    bool load(const std::string& filename);
+
+    /**
+     * @brief Writes weights in the format read by load()
+     */
+    static bool save(const std::string& filename, const std::vector<int16_t>& weights);
+
+    bool isLoaded() const {
+        return loaded;
+    }
+
+    /**
+     * @brief Computes all indices from scratch (search root)
+     */
+    static void setBoard(PatternState& state, const Board_t& board);
+
+    /**
+     * @brief Applies a move: the square becomes player's, flips change sides
+     */
+    static void play(PatternState& state, Move_t move, uint64_t flips, PlayerColor_t player);
+
+    /**
+     * @brief Reverts play() with the same arguments
+     */
+    static void undo(PatternState& state, Move_t move, uint64_t flips, PlayerColor_t player);
+
+    /**
+     * @brief Scores the position for the side to move
+     */
+    int evaluate(const PatternState& state, PlayerColor_t player, int emptyCount) const {
+        const int16_t* table = &weights[getPhase(emptyCount) * phaseSize];
+        int score = 0;
+
+        for (int i = 0; i < instanceCount; i++) {
+            score += table[instanceOffset[i] + state.index[i]];
+        }
+
+        return (player == PLAYER_BLACK) ? score : -score;
+    }
+
+    // Pattern set description (shared with the trainer)
+    static int getInstanceCount();
+    static const PatternInstance& getInstance(int instance);
+    static int getShapeSize(PatternShape shape);
+    static size_t getShapeOffset(PatternShape shape);
+    static size_t getWeightsPerPhase();
+
+    static uint32_t getInstanceOffset(int instance) {
+        return instanceOffset[instance];
+    }
+
+    static int getPhase(int emptyCount) {
+        int phase = (emptyCount - 1) / 4;
+        return (phase < 0) ? 0 : (phase >= PATTERN_PHASES ? PATTERN_PHASES - 1 : phase);
+    }
+};
+
+#endif // PATTERN_EVAL_H
@@ -0,0 +1,608 @@
+/**
+ * @brief Policy-based negamax search shared by the searching AIs
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef SEARCH_CORE_H
+#define SEARCH_CORE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include "../model.h"
+#include "transposition_table.h"
+
+// ============================================================================
+// Search Core Configuration
+// ============================================================================
+
+#define SEARCH_CORE_INFINITY 1000000000  // Safe to negate, unlike INT_MIN
+#define SEARCH_CORE_MAX_MOVES 64         // Upper bound on legal moves per position
+#define SEARCH_CORE_MAX_PLY 64           // Plies with their own move buffer
+
+/**
+ * @brief Legal move with its ordering score and the discs it flips
+ */
+struct SearchMove {
+    Move_t move;
+    int score;
+    uint64_t flips;
+};
+
+// ============================================================================
+// Policies
+// ============================================================================
+//
+// Evaluation: int evaluate(const Board_t&, PlayerColor_t, Table::Key)
+//             int evaluateFinal(const Board_t&, PlayerColor_t)
+//             void play(Move_t, uint64_t flips, PlayerColor_t mover)
+//             void undo(Move_t, uint64_t flips, PlayerColor_t mover)
+//   Scores from the given side's point of view. evaluate() scores leaves
+//   (and nodes reached after the limit); evaluateFinal() is called when
+//   neither side can move. play() and undo() follow every move the core
+//   makes, for evaluations with incremental state.
+//
+// Ordering:   bool enterNode(int ply)
+//             Move_t hashMove(bool onPv, int ply, Move_t tableMove)
+//             void order(const Board_t&, PlayerColor_t, SearchMove*, int count, int ply, Move_t hashMove)
+//             const SearchMove& pick(SearchMove*, int index, int count)
+//             int searchOrderDepth(int depth, Move_t hashMove)
+//             void enterChild(bool onPv, int ply, Move_t move)
+//             void updatePv(int ply, Move_t move)
+//             void onCutoff(const Board_t&, PlayerColor_t, Move_t, int depth, int ply)
+//   Chooses the order moves are searched in. enterNode() returns whether
+//   the node lies on the principal variation being followed, and
+//   updatePv() is called when a move (or MOVE_PASS) becomes the node's
+//   best line. searchOrderDepth() returns the depth of a search that
+//   re-scores every move before the real one, or -1 for none.
+//
+// Pruning:    static constexpr bool enabled
+//             bool upperBound(const Board_t&, PlayerColor_t, int depth, int emptyCount, int alpha, int& score)
+//   Alpha-beta cutoffs when enabled, full-width minimax otherwise.
+//   upperBound() may fail a node low before its moves are generated.
+//
+// Table:      typedef Key
+//             Key rootKey(const Board_t&, PlayerColor_t)
+//             Key childKey(Key, const SearchMove&, PlayerColor_t mover)
+//             Key passKey(Key)
+//             bool probe(Key, int depth, int emptyCount, int alpha, int beta, int& score, Move_t& move)
+//             void store(Key, int depth, int emptyCount, int score, int bound, Move_t move, uint64_t nodes)
+//             int probeChildren(Key, int depth, int emptyCount, int beta, PlayerColor_t,
+//                               const SearchMove*, int count, int& score)
+//   Remembers searched nodes. The empty-square count lets a table route
+//   nodes searched to the end of the game (depth >= emptyCount) apart.
+//   probeChildren() returns the index of a move whose stored bound
+//   already refutes the node, or -1.
+//
+// Passes:     static constexpr bool implicit
+//             static int depthAfterPass(int depth, int emptyCount)
+//   How a side without a legal move gives up its turn (see below).
+
+/**
+ * @brief Scores without incremental state
+ */
+struct StaticEvaluation {
+    void play(Move_t, uint64_t, PlayerColor_t) {
+    }
+    void undo(Move_t, uint64_t, PlayerColor_t) {
+    }
+};
+
+/**
+ * @brief Moves in generation order (ascending squares), no PV
+ */
+struct NoOrdering {
+    bool enterNode(int) {
+        return false;
+    }
+    Move_t hashMove(bool, int, Move_t tableMove) const {
+        return tableMove;
+    }
+    void order(const Board_t&, PlayerColor_t, SearchMove*, int, int, Move_t) {
+    }
+    const SearchMove& pick(SearchMove* moves, int index, int) const {
+        return moves[index];
+    }
+    int searchOrderDepth(int, Move_t) {
+        return -1;
+    }
+    void enterChild(bool, int, Move_t) {
+    }
+    void updatePv(int, Move_t) {
+    }
+    void onCutoff(const Board_t&, PlayerColor_t, Move_t, int, int) {
+    }
+};
+
+/**
+ * @brief Plain minimax: every move is searched
+ */
+struct FullWidthPruning {
+    static constexpr bool enabled = false;
+
+    bool upperBound(const Board_t&, PlayerColor_t, int, int, int, int&) const {
+        return false;
+    }
+};
+
+/**
+ * @brief Alpha-beta: a move that refutes the parent ends the node
+ */
+struct AlphaBetaPruning {
+    static constexpr bool enabled = true;
+
+    bool upperBound(const Board_t&, PlayerColor_t, int, int, int, int&) const {
+        return false;
+    }
+};
+
+/**
+ * @brief No transposition table: every node is searched
+ */
+struct NoTable {
+    struct Key {
+    };
+
+    Key rootKey(const Board_t&, PlayerColor_t) const {
+        return Key();
+    }
+    Key childKey(Key, const SearchMove&, PlayerColor_t) const {
+        return Key();
+    }
+    Key passKey(Key) const {
+        return Key();
+    }
+    bool probe(Key, int, int, int, int, int&, Move_t&) const {
+        return false;
+    }
+    void store(Key, int, int, int, int, Move_t, uint64_t) {
+    }
+    int probeChildren(Key, int, int, int, PlayerColor_t, const SearchMove*, int, int&) const {
+        return -1;
+    }
+};
+
+/**
+ * @brief A pass is a node of its own, with the opponent to move
+ *
+ * It costs one ply of depth, except inside a solve (depth >= empty
+ * squares), so the solve still reaches the end of the game.
+ */
+struct PassNodes {
+    static constexpr bool implicit = false;
+
+    static int depthAfterPass(int depth, int emptyCount) {
+        return (depth >= emptyCount) ? depth : depth - 1;
+    }
+};
+
+/**
+ * @brief The mover keeps the turn after a move its opponent cannot answer
+ *
+ * The sides scored still alternate ply by ply, so the node after such a
+ * move is scored for the opponent while the mover plays on. This is how
+ * Normal and Hard have always searched; it is kept so they choose the same
+ * moves as before.
+ */
+struct ImplicitPasses {
+    static constexpr bool implicit = true;
+
+    static int depthAfterPass(int depth, int) {
+        return depth - 1;
+    }
+};
+
+// ============================================================================
+// Search Core
+// ============================================================================
+
+/**
+ * @brief Negamax over bitboards, specialized at compile time
+ *
+ * Normal, Hard and Extreme all search with it. Each picks its policies;
+ * empty policies compile away, so an instantiation costs no more than a
+ * hand-written search of the same shape. searchRoot() is the fixed-depth
+ * root of Normal and Hard; Extreme drives search() from its own iterative
+ * deepening, MTD(f) and multi-PV roots.
+ *
+ * The node budget, the stop flag and the deadline flag are polled at every
+ * node. Once one trips the search is aborted: the node returns its static
+ * evaluation and every node above it unwinds without searching further
+ * moves. Their scores are truncated, so nothing is stored in the table or
+ * learned by the ordering after that point.
+ */
+template <class Evaluation, class Ordering, class Pruning, class Table, class Passes>
+class SearchCore {
+  public:
+    typedef typename Table::Key Key;
+
+    Evaluation evaluation;
+    Ordering ordering;
+    Pruning pruning;
+    Table table;
+
+  private:
+    uint64_t nodeLimit;
+    const std::atomic<bool>* stopFlag;      // Owned by the AI, may be null
+    const std::atomic<bool>* deadlineFlag;  // Owned by the AI, may be null
+    bool aborted;                           // Latched by checkLimits()
+
+    // ImplicitPasses: the side scored is the opponent of the side moving
+    bool sideSwapped;
+
+    // Statistics of the current (or last) search
+    uint64_t nodes;
+    uint64_t cutoffs;
+    uint64_t firstMoveCutoffs;
+    uint64_t evalCalls;
+    int selectiveDepth;
+
+    // Per-ply move buffers
+    SearchMove moveStack[SEARCH_CORE_MAX_PLY][SEARCH_CORE_MAX_MOVES];
+
+    static bool isRaised(const std::atomic<bool>* flag) {
+        return flag && flag->load(std::memory_order_relaxed);
+    }
+
+    PlayerColor_t scoredSide(PlayerColor_t player) const {
+        return (Passes::implicit && sideSwapped) ? getOpponent(player) : player;
+    }
+
+    int evaluate(const Board_t& board, PlayerColor_t player, Key key) {
+        evalCalls++;
+        return evaluation.evaluate(board, scoredSide(player), key);
+    }
+
+    int evaluateFinal(const Board_t& board, PlayerColor_t player) {
+        evalCalls++;
+        return evaluation.evaluateFinal(board, scoredSide(player));
+    }
+
+    int generateMoves(const Board_t& board, PlayerColor_t player, uint64_t legal, SearchMove* moves) const {
+        uint64_t playerBB = getPlayerBitboard(board, player);
+        uint64_t opponentBB = getOpponentBitboard(board, player);
+        int count = 0;
+
+        for (; legal; legal &= legal - 1) {
+            SearchMove& entry = moves[count++];
+            entry.move = bitScanForward(legal);
+            entry.score = 0;
+            entry.flips = calculateFlips(playerBB, opponentBB, entry.move);
+        }
+
+        return count;
+    }
+
+    int searchChild(Board_t& board,
+        PlayerColor_t player,
+        const SearchMove& move,
+        int depth,
+        int alpha,
+        int beta,
+        Key key,
+        int ply) {
+        PlayerColor_t nextPlayer = player;
+        BoardState_t state = applyMove(board, nextPlayer, move);
+        int score = -search(board, nextPlayer, depth, -beta, -alpha, table.childKey(key, move, player),
+            ply + 1);
+        revertMove(board, nextPlayer, state, move);
+        return score;
+    }
+
+  public:
+    SearchCore(const Evaluation& evaluationPolicy = Evaluation(),
+        const Ordering& orderingPolicy = Ordering(),
+        const Pruning& pruningPolicy = Pruning(),
+        const Table& tablePolicy = Table())
+        : evaluation(evaluationPolicy),
+          ordering(orderingPolicy),
+          pruning(pruningPolicy),
+          table(tablePolicy),
+          nodeLimit(0),
+          stopFlag(nullptr),
+          deadlineFlag(nullptr),
+          aborted(false),
+          sideSwapped(false),
+          nodes(0),
+          cutoffs(0),
+          firstMoveCutoffs(0),
+          evalCalls(0),
+          selectiveDepth(0) {
+    }
+
+    /**
+     * @brief Resets the statistics and sets the limits for a new search
+     *
+     * @param limit Node budget
+     * @param stop Stop request polled at every node (may be null)
+     * @param deadline Hard time limit flag polled at every node (may be null)
+     */
+    void begin(uint64_t limit, const std::atomic<bool>* stop, const std::atomic<bool>* deadline = nullptr) {
+        nodeLimit = limit;
+        stopFlag = stop;
+        deadlineFlag = deadline;
+        aborted = false;
+        sideSwapped = false;
+        nodes = 0;
+        cutoffs = 0;
+        firstMoveCutoffs = 0;
+        evalCalls = 0;
+        selectiveDepth = 0;
+    }
+
+    /**
+     * @brief Aborts the search if the node budget is spent, a stop was
+     * requested or the deadline passed
+     * @return True once the search is aborted
+     */
+    bool checkLimits() {
+        if (!aborted && (nodes >= nodeLimit || isRaised(stopFlag) || isRaised(deadlineFlag))) {
+            aborted = true;
+        }
+        return aborted;
+    }
+
+    bool isAborted() const {
+        return aborted;
+    }
+
+    bool stopRequested() const {
+        return isRaised(stopFlag);
+    }
+
+    /**
+     * @brief Lists the legal moves of a node in its ply's buffer, ordered
+     * @return Number of moves (see getMoves)
+     */
+    int prepareMoves(const Board_t& board, PlayerColor_t player, uint64_t legal, int ply, Move_t hashMove) {
+        int count = generateMoves(board, player, legal, moveStack[ply]);
+        ordering.order(board, player, moveStack[ply], count, ply, hashMove);
+        return count;
+    }
+
+    SearchMove* getMoves(int ply) {
+        return moveStack[ply];
+    }
+
+    /**
+     * @brief Plays a move from prepareMoves() and updates the evaluation
+     *
+     * player becomes the side to move next. With ImplicitPasses it stays
+     * the mover when the opponent has no reply.
+     */
+    BoardState_t applyMove(Board_t& board, PlayerColor_t& player, const SearchMove& move) {
+        BoardState_t state = { board.black, board.white, player };
+        uint64_t moveBit = 1ULL << move.move;
+
+        evaluation.play(move.move, move.flips, player);
+        if (player == PLAYER_BLACK) {
+            board.black |= moveBit | move.flips;
+            board.white &= ~move.flips;
+        }
+        else {
+            board.white |= moveBit | move.flips;
+            board.black &= ~move.flips;
+        }
+        player = getOpponent(player);
+
+        if (Passes::implicit && !hasValidMoves(board, player)) {
+            player = state.player;
+            sideSwapped = !sideSwapped;
+        }
+
+        return state;
+    }
+
+    /**
+     * @brief Takes back a move played by applyMove()
+     */
+    void revertMove(Board_t& board, PlayerColor_t& player, const BoardState_t& state, const SearchMove& move) {
+        if (Passes::implicit && player == state.player) {
+            sideSwapped = !sideSwapped;
+        }
+
+        board.black = state.black;
+        board.white = state.white;
+        player = state.player;
+        evaluation.undo(move.move, move.flips, player);
+    }
+
+    /**
+     * @brief Picks the best move of a position at a fixed depth
+     *
+     * Root moves are searched in generation order, each with a full window,
+     * as Normal and Hard always searched them. A move whose subtree was cut
+     * short by a stop request is ignored; one cut by the node budget keeps
+     * its (truncated) score.
+     *
+     * @return Best move, or the first legal move if none was searched
+     *         (MOVE_NONE if there is no legal move)
+     */
+    Move_t searchRoot(const Board_t& rootBoard, PlayerColor_t player, int depth) {
+        Board_t board = rootBoard;
+        uint64_t legal = getValidMovesBitmap(getPlayerBitboard(board, player),
+            getOpponentBitboard(board, player));
+
+        if (!legal) {
+            return MOVE_NONE;
+        }
+
+        Key key = table.rootKey(board, player);
+        SearchMove* moves = moveStack[0];
+        int moveCount = generateMoves(board, player, legal, moves);
+
+        Move_t bestMove = moves[0].move;
+        int bestScore = -SEARCH_CORE_INFINITY;
+
+        for (int i = 0; i < moveCount; i++) {
+            if (checkLimits()) {
+                break;
+            }
+
+            int score = searchChild(board, player, moves[i], depth - 1, -SEARCH_CORE_INFINITY,
+                SEARCH_CORE_INFINITY, key, 0);
+
+            // A stop request truncates this subtree: its score cannot be trusted
+            if (stopRequested()) {
+                break;
+            }
+
+            if (score > bestScore) {
+                bestScore = score;
+                bestMove = moves[i].move;
+            }
+        }
+
+        return bestMove;
+    }
+
+    /**
+     * @brief Negamax search of one node
+     * @return Score from the point of view of the side to move (with
+     *         ImplicitPasses, of the side scored at this ply)
+     */
+    int search(Board_t& board, PlayerColor_t player, int depth, int alpha, int beta, Key key, int ply) {
+        uint64_t subtreeStart = nodes++;
+        selectiveDepth = std::max(selectiveDepth, ply);
+        bool onPv = ordering.enterNode(ply);
+
+        if (checkLimits()) {
+            return evaluate(board, player, key);
+        }
+
+        int emptyCount = getEmptyCount(board);
+        int score;
+        Move_t tableMove = MOVE_NONE;
+        if (table.probe(key, depth, emptyCount, alpha, beta, score, tableMove)) {
+            return score;
+        }
+
+        if (depth <= 0) {
+            score = evaluate(board, player, key);
+            table.store(key, depth, emptyCount, score, BOUND_EXACT, MOVE_NONE, nodes - subtreeStart);
+            return score;
+        }
+
+        uint64_t playerBB = getPlayerBitboard(board, player);
+        uint64_t opponentBB = getOpponentBitboard(board, player);
+        uint64_t legal = getValidMovesBitmap(playerBB, opponentBB);
+
+        if (!legal && !getValidMovesBitmap(opponentBB, playerBB)) {
+            score = evaluateFinal(board, player);
+            table.store(key, depth, emptyCount, score, BOUND_EXACT, MOVE_NONE, nodes - subtreeStart);
+            return score;
+        }
+
+        if (pruning.upperBound(board, player, depth, emptyCount, alpha, score)) {
+            table.store(key, depth, emptyCount, score, BOUND_UPPER, MOVE_NONE, nodes - subtreeStart);
+            return score;
+        }
+
+        // Pass: the opponent moves from the same position
+        if (!legal) {
+            ordering.enterChild(onPv, ply, MOVE_PASS);
+            score = -search(board, getOpponent(player), Passes::depthAfterPass(depth, emptyCount), -beta,
+                -alpha, table.passKey(key), ply + 1);
+            ordering.updatePv(ply, MOVE_PASS);
+            return score;
+        }
+
+        Move_t hashMove = ordering.hashMove(onPv, ply, tableMove);
+        int moveCount = prepareMoves(board, player, legal, ply, hashMove);
+        SearchMove* moves = moveStack[ply];
+
+        int refutation = table.probeChildren(key, depth, emptyCount, beta, player, moves, moveCount, score);
+        if (refutation >= 0) {
+            table.store(key, depth, emptyCount, score, BOUND_LOWER, moves[refutation].move,
+                nodes - subtreeStart);
+            return score;
+        }
+
+        int orderDepth = ordering.searchOrderDepth(depth, hashMove);
+        if (orderDepth >= 0) {
+            for (int i = 0; i < moveCount; i++) {
+                moves[i].score = searchChild(board, player, moves[i], orderDepth, -SEARCH_CORE_INFINITY,
+                    SEARCH_CORE_INFINITY, key, ply);
+
+                if (aborted) {
+                    return -SEARCH_CORE_INFINITY;
+                }
+            }
+        }
+
+        int bestScore = -SEARCH_CORE_INFINITY;
+        Move_t bestMove = MOVE_NONE;
+        int bound = BOUND_UPPER;
+
+        for (int i = 0; i < moveCount && !aborted; i++) {
+            const SearchMove& next = ordering.pick(moves, i, moveCount);
+
+            ordering.enterChild(onPv, ply, next.move);
+            score = searchChild(board, player, next, depth - 1, alpha, beta, key, ply);
+
+            if (score > bestScore) {
+                bestScore = score;
+                bestMove = next.move;
+            }
+
+            if (score > alpha) {
+                alpha = score;
+                bound = BOUND_EXACT;
+                ordering.updatePv(ply, next.move);
+            }
+
+            if (Pruning::enabled && alpha >= beta) {
+                countCutoff(i);
+                if (!aborted) {
+                    ordering.onCutoff(board, player, next.move, depth, ply);
+                }
+                bound = BOUND_LOWER;
+                break;
+            }
+        }
+
+        if (!aborted) {
+            table.store(key, depth, emptyCount, bestScore, bound, bestMove, nodes - subtreeStart);
+        }
+
+        return bestScore;
+    }
+
+    /**
+     * @brief Counts a beta cutoff (for root drivers outside search())
+     * @param moveIndex Position of the refuting move in the search order
+     */
+    void countCutoff(int moveIndex) {
+        cutoffs++;
+        if (moveIndex == 0) {
+            firstMoveCutoffs++;
+        }
+    }
+
+    // Statistics getters
+    uint64_t getNodes() const {
+        return nodes;
+    }
+    uint64_t getCutoffs() const {
+        return cutoffs;
+    }
+    uint64_t getFirstMoveCutoffs() const {
+        return firstMoveCutoffs;
+    }
+    uint64_t getEvalCalls() const {
+        return evalCalls;
+    }
+    int getSelectiveDepth() const {
+        return selectiveDepth;
+    }
+};
+
+#endif // SEARCH_CORE_H
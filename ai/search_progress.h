@@ -0,0 +1,89 @@
+/**
+ * @brief Search progress snapshots published by the engine to the UI
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef SEARCH_PROGRESS_H
+#define SEARCH_PROGRESS_H
+
+#include <atomic>
+#include <cstdint>
+
+#include "../model.h"
+
+#define SEARCH_PROGRESS_MAX_PV 16
+
+/**
+ * @brief State of a running (or the last) search
+ */
+struct SearchProgress {
+    bool active;        // False once the search has returned
+    bool pondering;     // Searching on the opponent's time
+    int depth;          // Last completed iteration (0 = none yet)
+    int score;          // Score of that iteration, side to move's view
+    uint64_t nodes;
+    double elapsed;     // Seconds since the search started
+    int pvLength;
+    Move_t pv[SEARCH_PROGRESS_MAX_PV];
+};
+
+/**
+ * @brief Lock-free triple buffer carrying the latest SearchProgress
+ *
+ * One writer (the search thread) and one reader (the render loop). The
+ * writer fills its private slot and swaps it with the shared middle slot;
+ * the reader swaps the middle slot with its own when a new snapshot is
+ * flagged. Neither side ever waits, and the reader always sees a complete
+ * snapshot (older ones are simply skipped).
+ */
+class SearchProgressBuffer {
+  private:
+    SearchProgress slots[3];
+
+    // Low two bits: index of the middle slot; FRESH_BIT: not yet read
+    static constexpr unsigned FRESH_BIT = 4;
+    std::atomic<unsigned> middle{1};
+
+    unsigned writeIndex = 0;  // Writer thread only
+    unsigned readIndex = 2;   // Reader thread only
+
+  public:
+    SearchProgressBuffer() {
+        for (SearchProgress& slot : slots) {
+            slot = SearchProgress{};
+        }
+    }
+
+    /**
+     * @brief Publishes a snapshot (writer thread only)
+     */
+    void publish(const SearchProgress& progress) {
+        slots[writeIndex] = progress;
+        unsigned previous = middle.exchange(writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+        writeIndex = previous & 3;
+    }
+
+    /**
+     * @brief Fetches the newest snapshot, if any (reader thread only)
+     * @return False if nothing was published since the last call
+     */
+    bool read(SearchProgress& progress) {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH_BIT)) {
+            return false;
+        }
+
+        unsigned previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & 3;
+        progress = slots[readIndex];
+        return true;
+    }
+};
+
+#endif // SEARCH_PROGRESS_H
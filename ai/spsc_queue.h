@@ -0,0 +1,69 @@
+/**
+ * @brief Lock-free single-producer / single-consumer ring buffer
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Bounded FIFO for exactly one producer thread and one consumer thread
+ *
+ * Used to hand results from the AI worker to the render loop without ever
+ * blocking either side. Capacity must be a power of two.
+ */
+template <typename T, size_t Capacity>
+class SPSCQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SPSCQueue capacity must be a power of two");
+
+  private:
+    T buffer[Capacity];
+
+    // Kept on separate cache lines so producer and consumer do not contend
+    alignas(64) std::atomic<size_t> head{0};  // Next slot to read (consumer)
+    alignas(64) std::atomic<size_t> tail{0};  // Next slot to write (producer)
+
+  public:
+    /**
+     * @brief Appends an item (producer thread only)
+     * @return False if the queue is full
+     */
+    bool push(const T& item) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        buffer[currentTail & (Capacity - 1)] = item;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest item (consumer thread only)
+     * @return False if the queue is empty
+     */
+    bool pop(T& item) {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        item = buffer[currentHead & (Capacity - 1)];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+#endif // SPSC_QUEUE_H
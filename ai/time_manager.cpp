@@ -0,0 +1,203 @@
+/**
+ * @brief Clock-aware time management for the search AIs
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "time_manager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// ============================================================================
+// Constructor
+// ============================================================================
+
+TimeManager::TimeManager()
+    : fixedSoftLimit(0.0),
+      fixedHardLimit(0.0),
+      softLimit(TM_MAX_MOVE_S),
+      hardLimit(TM_MAX_MOVE_S),
+      stabilityFactor(1.0),
+      lastBestMove(MOVE_NONE),
+      stableIterations(0),
+      lastIterationEnd(0.0),
+      lastIterationTime(0.0),
+      prevIterationTime(0.0),
+      deadlineArmed(false),
+      shuttingDown(false),
+      hardExpired(false) {
+    startTime = std::chrono::steady_clock::now();
+    deadline = startTime;
+    deadlineThread = std::thread(&TimeManager::deadlineLoop, this);
+}
+
+TimeManager::~TimeManager() {
+    {
+        std::lock_guard<std::mutex> lock(deadlineMutex);
+        shuttingDown = true;
+    }
+    deadlineCondition.notify_one();
+    deadlineThread.join();
+}
+
+// ============================================================================
+// Limits
+// ============================================================================
+
+void TimeManager::setLimits(double softSeconds, double hardSeconds) {
+    fixedSoftLimit = std::max(softSeconds, 0.0);
+    fixedHardLimit = std::max(hardSeconds, 0.0);
+}
+
+void TimeManager::getLimits(double& softSeconds, double& hardSeconds) const {
+    softSeconds = softLimit;
+    hardSeconds = hardLimit;
+}
+
+void TimeManager::startMove(double usedSeconds, int emptyCount) {
+    startTime = std::chrono::steady_clock::now();
+
+    // Split what is left of the game budget over our remaining moves
+    double remaining = std::max(TM_GAME_BUDGET_S - usedSeconds, 0.0);
+    int movesLeft = (emptyCount + 1) / 2 + TM_RESERVE_MOVES;
+    double planned = remaining / movesLeft;
+
+    softLimit = (fixedSoftLimit > 0.0)
+        ? fixedSoftLimit
+        : std::clamp(planned, TM_MIN_MOVE_S, TM_MAX_MOVE_S);
+
+    if (fixedHardLimit > 0.0) {
+        hardLimit = fixedHardLimit;
+    }
+    else {
+        // Never risk more than half of what is left on a single move
+        hardLimit = std::min(softLimit * TM_HARD_FACTOR, TM_MAX_MOVE_S);
+        hardLimit = std::min(hardLimit, std::max(remaining * 0.5, TM_MIN_MOVE_S));
+    }
+    hardLimit = std::max(hardLimit, softLimit);
+
+    resetIterations();
+    armDeadline(hardLimit);
+}
+
+void TimeManager::startPondering() {
+    startTime = std::chrono::steady_clock::now();
+
+    // Pondering ends when the opponent moves (stop()), not on the clock
+    softLimit = std::numeric_limits<double>::infinity();
+    hardLimit = std::numeric_limits<double>::infinity();
+
+    resetIterations();
+    armDeadline(hardLimit);
+}
+
+void TimeManager::stopClock() {
+    armDeadline(std::numeric_limits<double>::infinity());
+}
+
+void TimeManager::resetIterations() {
+    stabilityFactor = 1.0;
+    lastBestMove = MOVE_NONE;
+    stableIterations = 0;
+    lastIterationEnd = 0.0;
+    lastIterationTime = 0.0;
+    prevIterationTime = 0.0;
+}
+
+// ============================================================================
+// Iteration control
+// ============================================================================
+
+void TimeManager::onIterationComplete(Move_t bestMove, int depth) {
+    double now = elapsed();
+    prevIterationTime = lastIterationTime;
+    lastIterationTime = now - lastIterationEnd;
+    lastIterationEnd = now;
+
+    // Shallow iterations flip-flop too much to say anything about stability
+    if (depth >= 4 && lastBestMove != MOVE_NONE) {
+        if (bestMove != lastBestMove) {
+            // Late change of mind: give the new move time to be confirmed
+            stableIterations = 0;
+            stabilityFactor = 1.5;
+        }
+        else if (++stableIterations >= 3) {
+            // Same answer for several iterations: more time is unlikely to help
+            stabilityFactor = 0.6;
+        }
+        else {
+            stabilityFactor = 1.0;
+        }
+    }
+
+    lastBestMove = bestMove;
+}
+
+bool TimeManager::canStartIteration() const {
+    double budget = std::min(softLimit * stabilityFactor, hardLimit);
+    double now = elapsed();
+
+    if (now >= budget) {
+        return false;
+    }
+
+    // Predict the next iteration from the growth of the last two
+    double growth = TM_BRANCHING_MIN;
+    if (prevIterationTime > 0.0) {
+        growth = std::clamp(lastIterationTime / prevIterationTime, TM_BRANCHING_MIN, TM_BRANCHING_MAX);
+    }
+
+    return now + lastIterationTime * growth <= budget;
+}
+
+double TimeManager::elapsed() const {
+    auto currentTime = std::chrono::steady_clock::now();
+    std::chrono::duration<double> duration = currentTime - startTime;
+    return duration.count();
+}
+
+// ============================================================================
+// Hard limit watcher
+// ============================================================================
+
+void TimeManager::armDeadline(double seconds) {
+    {
+        std::lock_guard<std::mutex> lock(deadlineMutex);
+        hardExpired.store(false, std::memory_order_relaxed);
+
+        // No limit (pondering, idle, or too far to represent) leaves the
+        // watcher asleep
+        deadlineArmed = std::isfinite(seconds) && seconds < 1e9;
+        if (deadlineArmed) {
+            deadline = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(seconds));
+        }
+    }
+    deadlineCondition.notify_one();
+}
+
+void TimeManager::deadlineLoop() {
+    std::unique_lock<std::mutex> lock(deadlineMutex);
+
+    while (!shuttingDown) {
+        if (!deadlineArmed) {
+            deadlineCondition.wait(lock);
+        }
+        else if (std::chrono::steady_clock::now() >= deadline) {
+            hardExpired.store(true, std::memory_order_relaxed);
+            deadlineArmed = false;
+        }
+        else {
+            // Woken early by re-arming, shutdown or spuriously: re-check
+            deadlineCondition.wait_until(lock, deadline);
+        }
+    }
+}
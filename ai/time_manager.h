@@ -0,0 +1,151 @@
+/**
+ * @brief Clock-aware time management for the search AIs
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef TIME_MANAGER_H
+#define TIME_MANAGER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "../model.h"
+
+// ============================================================================
+// Time Management Configuration
+// ============================================================================
+
+#define TM_GAME_BUDGET_S 300.0   // Thinking time for the whole game (per side)
+#define TM_MAX_MOVE_S 15.0       // Never think longer than this on a single move
+#define TM_MIN_MOVE_S 0.05       // Always allow at least this much
+#define TM_HARD_FACTOR 3.0       // Hard limit = soft limit * factor (clamped)
+#define TM_RESERVE_MOVES 2       // Extra moves kept in reserve when splitting the clock
+#define TM_BRANCHING_MIN 2.0     // Bounds for the predicted iteration growth
+#define TM_BRANCHING_MAX 8.0
+
+/**
+ * @brief Allocates thinking time per move from the remaining game clock
+ *
+ * The soft limit is the planned time for the move: the iterative deepening
+ * driver does not start an iteration it predicts will end past it. The hard
+ * limit is an absolute ceiling polled inside the search. The soft limit is
+ * stretched when the best move changes late and shrunk when it is stable.
+ *
+ * The hard limit is enforced by a watcher thread that sleeps until the
+ * deadline and then raises a flag, so polling it costs an atomic load
+ * instead of a clock read.
+ */
+class TimeManager {
+  private:
+    std::chrono::time_point<std::chrono::steady_clock> startTime;
+
+    double fixedSoftLimit;  // User override (0 = derive from clock)
+    double fixedHardLimit;  // User override (0 = derive from clock)
+
+    double softLimit;       // Current move's planned time
+    double hardLimit;       // Current move's absolute ceiling
+    double stabilityFactor; // Scales softLimit by best-move stability
+
+    Move_t lastBestMove;
+    int stableIterations;
+    double lastIterationEnd;
+    double lastIterationTime;
+    double prevIterationTime;
+
+    // Hard limit watcher
+    std::thread deadlineThread;
+    std::mutex deadlineMutex;                    // Guards the fields below
+    std::condition_variable deadlineCondition;   // Signals re-arming / shutdown
+    std::chrono::time_point<std::chrono::steady_clock> deadline;
+    bool deadlineArmed;
+    bool shuttingDown;
+    std::atomic<bool> hardExpired;               // Set by the watcher at the deadline
+
+    void resetIterations();
+    void armDeadline(double seconds);
+    void deadlineLoop();
+
+  public:
+    TimeManager();
+    ~TimeManager();
+
+    TimeManager(const TimeManager&) = delete;
+    TimeManager& operator=(const TimeManager&) = delete;
+
+    /**
+     * @brief Overrides the automatic allocation
+     *
+     * @param softSeconds Planned time per move (0 = automatic)
+     * @param hardSeconds Absolute ceiling per move (0 = automatic)
+     */
+    void setLimits(double softSeconds, double hardSeconds);
+
+    /**
+     * @brief Gets the limits of the current (or last) move
+     */
+    void getLimits(double& softSeconds, double& hardSeconds) const;
+
+    /**
+     * @brief Starts the clock for a new move and allocates its budget
+     *
+     * @param usedSeconds Time already spent by the side to move this game
+     * @param emptyCount Empty squares left on the board
+     */
+    void startMove(double usedSeconds, int emptyCount);
+
+    /**
+     * @brief Starts the clock for a ponder search, with no time limits
+     */
+    void startPondering();
+
+    /**
+     * @brief Disarms the hard limit once the search is over
+     */
+    void stopClock();
+
+    /**
+     * @brief Records a finished iteration and updates best-move stability
+     *
+     * @param bestMove Best move found by the iteration
+     * @param depth Depth of the iteration
+     */
+    void onIterationComplete(Move_t bestMove, int depth);
+
+    /**
+     * @brief Checks whether another iteration is expected to fit in the soft limit
+     */
+    bool canStartIteration() const;
+
+    /**
+     * @brief Checks the absolute ceiling (polled inside the search)
+     *
+     * A single atomic load: cheap enough to call at every node.
+     */
+    bool hardLimitReached() const {
+        return hardExpired.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief The flag behind hardLimitReached(), for searches that poll it
+     */
+    const std::atomic<bool>* getHardLimitFlag() const {
+        return &hardExpired;
+    }
+
+    /**
+     * @brief Seconds since startMove()
+     */
+    double elapsed() const;
+};
+
+#endif // TIME_MANAGER_H
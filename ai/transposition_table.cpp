@@ -12,8 +12,8 @@
 
 #include "transposition_table.h"
 
+#include <algorithm>
 #include <cmath>
-#include <cstring>
 #include <iostream>
 #include <random>
 
@@ -21,10 +21,14 @@
 // Constructor / Destructor
 // ============================================================================
 
-TranspositionTable::TranspositionTable() {
-    size = TT_ENTRIES;
+TranspositionTable::TranspositionTable(size_t megabytes, int depthGain, const char* label) {
+    sizeMB = megabytes;
+    name = label;
+    size = (sizeMB * 1024 * 1024) / sizeof(TTEntry);
     table = new TTEntry[size];
     currentAge = 0;
+    replacement = TT_REPLACE_DEPTH;
+    minDepthGain = depthGain;
     hits = 0;
     misses = 0;
     collisions = 0;
@@ -32,8 +36,7 @@ TranspositionTable::TranspositionTable() {
     initZobrist();
     clear();
 
-    std::cout << "Transposition Table initialized: " << TT_SIZE_MB << " MB (" << size << " entries)"
-              << std::endl;
+    std::cout << name << " initialized: " << sizeMB << " MB (" << size << " entries)" << std::endl;
 }
 
 TranspositionTable::~TranspositionTable() {
@@ -61,7 +64,7 @@ void TranspositionTable::initZobrist() {
 }
 
 void TranspositionTable::clear() {
-    memset(table, 0, size * sizeof(TTEntry));
+    std::fill(table, table + size, TTEntry());
     currentAge = 0;
     hits = 0;
     misses = 0;
@@ -163,31 +166,44 @@ bool TranspositionTable::probe(
         return false;  // Not deep enough, can't use score
     }
 
-    // Check bound type and validate score
-    int storedScore = entry.score;
-
-    if (entry.bound == BOUND_EXACT) {
+    if (entry.lower == entry.upper) {
         // Exact score - can use directly
-        score = storedScore;
+        score = entry.lower;
         return true;
-    } else if (entry.bound == BOUND_LOWER) {
+    }
+    if (entry.lower >= beta) {
         // Lower bound (failed high / beta cutoff)
-        if (storedScore >= beta) {
-            score = storedScore;
-            return true;
-        }
-    } else if (entry.bound == BOUND_UPPER) {
+        score = entry.lower;
+        return true;
+    }
+    if (entry.upper <= alpha) {
         // Upper bound (failed low / alpha cutoff)
-        if (storedScore <= alpha) {
-            score = storedScore;
-            return true;
-        }
+        score = entry.upper;
+        return true;
     }
 
     return false;  // Score not usable
 }
 
-void TranspositionTable::store(uint64_t hash, int depth, int score, int bound, Move_t bestMove) {
+bool TranspositionTable::probeCutoff(uint64_t childHash, int depth, int beta, int& score) const {
+    const TTEntry& entry = table[getIndex(childHash)];
+
+    if (entry.zobristKey != childHash || entry.depth < depth) {
+        return false;
+    }
+
+    // Child score is from the opponent's point of view: an upper bound
+    // (or exact score) at or below -beta means the parent scores >= beta
+    if (entry.upper <= -beta) {
+        score = -entry.upper;
+        return true;
+    }
+
+    return false;
+}
+
+void TranspositionTable::store(
+    uint64_t hash, int depth, int score, int bound, Move_t bestMove, uint64_t nodes) {
     size_t index = getIndex(hash);
     TTEntry& entry = table[index];
 
@@ -206,22 +222,53 @@ void TranspositionTable::store(uint64_t hash, int depth, int score, int bound, M
 
         // Replace if:
         // 1. Current entry is old (different generation)
-        // 2. OR new entry is significantly deeper
+        // 2. OR new entry is significantly deeper (or took more nodes)
         if (entry.age != currentAge) {
             replace = true;
-        } else if (depth > entry.depth + 2) {
+        } else if (replacement == TT_REPLACE_NODES) {
+            replace = compressNodeCount(nodes) >= entry.nodeBits;
+        } else if (depth >= entry.depth + minDepthGain) {
             replace = true;
         }
     }
 
-    if (replace) {
+    if (!replace) {
+        return;
+    }
+
+    // Same search again: tighten the bounds. A bound contradicting the
+    // other one (search instability) drops it instead.
+    bool merge = entry.zobristKey == hash && entry.depth == depth;
+    if (!merge) {
         entry.zobristKey = hash;
         entry.depth = depth;
-        entry.score = score;
-        entry.bound = bound;
+        entry.lower = TT_NO_LOWER;
+        entry.upper = TT_NO_UPPER;
+        entry.bestMove = MOVE_NONE;
+        entry.nodeBits = 0;
+    }
+    entry.nodeBits = std::max(entry.nodeBits, compressNodeCount(nodes));
+
+    if (bound == BOUND_EXACT) {
+        entry.lower = score;
+        entry.upper = score;
+    } else if (bound == BOUND_LOWER) {
+        entry.lower = std::max(entry.lower, score);
+        if (entry.upper < entry.lower) {
+            entry.upper = TT_NO_UPPER;
+        }
+    } else {
+        entry.upper = std::min(entry.upper, score);
+        if (entry.lower > entry.upper) {
+            entry.lower = TT_NO_LOWER;
+        }
+    }
+
+    // A failed-low node's move is only the least refuted one
+    if (bestMove != MOVE_NONE && (bound != BOUND_UPPER || entry.bestMove == MOVE_NONE)) {
         entry.bestMove = bestMove;
-        entry.age = currentAge;
     }
+    entry.age = currentAge;
 }
 
 Move_t TranspositionTable::getBestMove(uint64_t hash) const {
@@ -254,8 +301,8 @@ _mm_prefetch(reinterpret_cast<const char*>(&table[index]), _MM_HINT_T0);
 void TranspositionTable::printStats() const {
     uint64_t total = hits + misses;
 
-    std::cout << "\n=== Transposition Table Statistics ===" << std::endl;
-    std::cout << "Size: " << TT_SIZE_MB << " MB (" << size << " entries)" << std::endl;
+    std::cout << "\n=== " << name << " Statistics ===" << std::endl;
+    std::cout << "Size: " << sizeMB << " MB (" << size << " entries)" << std::endl;
     std::cout << "Lookups: " << total << std::endl;
     std::cout << "Hits: " << hits << " (" << (getHitRate() * 100.0) << "%)" << std::endl;
     std::cout << "Misses: " << misses << std::endl;
@@ -12,6 +12,7 @@
 #ifndef TRANSPOSITION_TABLE_H
 #define TRANSPOSITION_TABLE_H
 
+#include <cstddef>
 #include <cstdint>
 
 #include "../model.h"
@@ -20,14 +21,41 @@
 // Transposition Table Configuration
 // ============================================================================
 
-#define TT_SIZE_MB 256  // Table size in megabytes
-#define TT_ENTRIES ((TT_SIZE_MB * 1024 * 1024) / sizeof(TTEntry))
+#define TT_SIZE_MB 256          // Table size in megabytes
+#define ENDGAME_TT_SIZE_MB 32   // Size of the endgame solver's table
+#define TT_MIN_DEPTH_GAIN 3     // Extra plies needed to replace a colliding entry
 
 // Bound types for alpha-beta scores
 #define BOUND_EXACT 0  // Exact score (PV node)
 #define BOUND_LOWER 1  // Alpha cutoff (>=)
 #define BOUND_UPPER 2  // Beta cutoff (<=)
 
+// Bounds of an entry that has not been searched that way yet
+#define TT_NO_LOWER INT32_MIN
+#define TT_NO_UPPER INT32_MAX
+
+/**
+ * @brief Which entry survives a collision within the current search
+ */
+enum TTReplacement {
+    TT_REPLACE_DEPTH,  // Deeper entry (by the table's minimum depth gain)
+    TT_REPLACE_NODES   // Entry whose subtree took more nodes
+};
+
+/**
+ * @brief Compresses a subtree node count to its bit length (0-64)
+ *
+ * Enough to compare subtree sizes within a factor of two.
+ */
+inline uint8_t compressNodeCount(uint64_t nodes) {
+    uint8_t bits = 0;
+    while (nodes) {
+        nodes >>= 1;
+        bits++;
+    }
+    return bits;
+}
+
 // ============================================================================
 // Transposition Table Entry
 // ============================================================================
@@ -35,19 +63,30 @@
 /**
  * @brief Entry stored in the transposition table
  *
+ * Keeps a lower and an upper bound on the score, so a position that failed
+ * high in one search and low in another (as null-window searches do) keeps
+ * both results. Equal bounds mean the score is exact.
+ *
  * Size: 24 bytes (compact for cache efficiency)
  */
 struct TTEntry {
     uint64_t zobristKey;  // 8 bytes - Position hash (for verification)
-    int score;            // 4 bytes - Evaluation score
+    int lower;            // 4 bytes - Score is >= lower
+    int upper;            // 4 bytes - Score is <= upper
     Move_t bestMove;      // 1 byte  - Best move from this position
     int8_t depth;         // 1 byte  - Search depth
-    uint8_t bound;        // 1 byte  - Bound type (EXACT/LOWER/UPPER)
     uint8_t age;          // 1 byte  - Generation counter (for replacement)
-    // Padding: 8 bytes implicit
+    uint8_t nodeBits;     // 1 byte  - Subtree size (see compressNodeCount)
+    // Padding: 4 bytes implicit
 
     TTEntry()
-        : zobristKey(0), score(0), bestMove(MOVE_NONE), depth(-1), bound(BOUND_EXACT), age(0) {
+        : zobristKey(0),
+          lower(TT_NO_LOWER),
+          upper(TT_NO_UPPER),
+          bestMove(MOVE_NONE),
+          depth(-1),
+          age(0),
+          nodeBits(0) {
     }
 };
 
@@ -55,11 +94,25 @@ struct TTEntry {
 // Transposition Table Class
 // ============================================================================
 
+/**
+ * @brief Hash table of searched positions, keyed by Zobrist hash
+ *
+ * The endgame solver keeps a second, smaller instance for positions
+ * searched to the end of the game. There the depth is the number of empty
+ * squares: it is the same for every search of a position, so a solved
+ * entry answers any later probe, and a minimum depth gain of 0 keeps the
+ * bigger solve on a collision. Depth-limited midgame results would
+ * otherwise push out solves worth millions of nodes.
+ */
 class TranspositionTable {
   private:
     TTEntry* table;      // Hash table
     size_t size;         // Number of entries
+    size_t sizeMB;       // Size in megabytes (for the statistics)
+    const char* name;    // Label for the log and statistics
     uint8_t currentAge;  // Current generation
+    TTReplacement replacement;
+    int minDepthGain;    // Depth a new entry needs over a colliding one
 
     // Zobrist hash tables (random numbers for hashing)
     uint64_t zobristPieces[2][64];  // [player][position]
@@ -81,7 +134,15 @@ class TranspositionTable {
     void initZobrist();
 
   public:
-    TranspositionTable();
+    /**
+     * @param megabytes Table size
+     * @param depthGain Extra depth a new entry needs to replace a colliding
+     *                  entry of the current search
+     * @param label Name printed in the log and statistics
+     */
+    explicit TranspositionTable(size_t megabytes = TT_SIZE_MB,
+        int depthGain = TT_MIN_DEPTH_GAIN,
+        const char* label = "Transposition Table");
     ~TranspositionTable();
 
     /**
@@ -127,16 +188,41 @@ class TranspositionTable {
      */
     bool probe(uint64_t hash, int depth, int alpha, int beta, int& score, Move_t& bestMove);
 
+    /**
+     * @brief Enhanced Transposition Cutoff probe for a child position
+     *
+     * Checks whether the stored entry of a child already proves that the
+     * parent fails high, without counting as a regular hit or miss.
+     *
+     * @param childHash Hash of the position after the move
+     * @param depth Remaining depth required at the child
+     * @param beta Parent's beta bound
+     * @param score Output: parent score (negated child score) on cutoff
+     * @return True if the child refutes the parent's window
+     */
+    bool probeCutoff(uint64_t childHash, int depth, int beta, int& score) const;
+
     /**
      * @brief Stores position in transposition table
      *
+     * A result at the depth already stored for the same position tightens
+     * that entry's bounds instead of replacing them.
+     *
      * @param hash Position hash
      * @param depth Search depth
      * @param score Evaluation score
      * @param bound Bound type (EXACT/LOWER/UPPER)
      * @param bestMove Best move from this position
+     * @param nodes Nodes searched under this position for the result
+     */
+    void store(uint64_t hash, int depth, int score, int bound, Move_t bestMove, uint64_t nodes);
+
+    /**
+     * @brief Selects how collisions within a search are resolved
      */
-    void store(uint64_t hash, int depth, int score, int bound, Move_t bestMove);
+    void setReplacement(TTReplacement policy) {
+        replacement = policy;
+    }
 
     /**
      * @brief Gets best move from table without score validation
@@ -0,0 +1,75 @@
+/**
+ * @brief WThor database reader implementation
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "wthor_database.h"
+
+#include <fstream>
+#include <iostream>
+#include <utility>
+
+Move_t decodeWThorMove(uint8_t wthorMove) {
+    // Examples: A1 = 11, H1 = 18, A8 = 81, H8 = 88
+    int row = (wthorMove / 10) - 1;
+    int col = (wthorMove % 10) - 1;
+
+    if (row < 0 || row >= 8 || col < 0 || col >= 8) {
+        return MOVE_NONE;
+    }
+
+    return coordsToMove(col, row);
+}
+
+int readWThorFile(const std::string& filename, std::vector<WThorGame>& games) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open database: " << filename << std::endl;
+        return 0;
+    }
+
+    uint8_t header[WTHOR_HEADER_SIZE];
+    file.read(reinterpret_cast<char*>(header), WTHOR_HEADER_SIZE);
+    if (!file) {
+        std::cerr << "Failed to read header from: " << filename << std::endl;
+        return 0;
+    }
+
+    // Little-endian game count
+    int gameCount = header[4] | (header[5] << 8) | (header[6] << 16) | (header[7] << 24);
+    int theoreticalDepth = header[14];
+    int gamesRead = 0;
+
+    for (int g = 0; g < gameCount; g++) {
+        uint8_t gameData[WTHOR_RECORD_SIZE];
+        file.read(reinterpret_cast<char*>(gameData), WTHOR_RECORD_SIZE);
+        if (!file)
+            break;
+
+        WThorGame game;
+        game.blackScore = gameData[6];
+        game.theoreticalScore = gameData[7];
+        game.theoreticalDepth = theoreticalDepth;
+
+        for (int i = 8; i < WTHOR_RECORD_SIZE; i++) {
+            Move_t move = decodeWThorMove(gameData[i]);
+            if (move == MOVE_NONE)
+                break;
+            game.moves.push_back(move);
+        }
+
+        if (!game.moves.empty()) {
+            games.push_back(std::move(game));
+            gamesRead++;
+        }
+    }
+
+    return gamesRead;
+}
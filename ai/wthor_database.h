@@ -0,0 +1,58 @@
+/**
+ * @brief Reader for WThor game databases (.wtb)
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef WTHOR_DATABASE_H
+#define WTHOR_DATABASE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../model.h"
+
+// ============================================================================
+// WThor File Layout
+// ============================================================================
+
+#define WTHOR_HEADER_SIZE 16  // Game count in bytes 4-7, theoretical depth in byte 14
+#define WTHOR_RECORD_SIZE 68  // Scores in bytes 6-7, moves in bytes 8-67
+
+/**
+ * @brief One database game: moves in play order and black's disc counts
+ */
+struct WThorGame {
+    std::vector<Move_t> moves;
+    int blackScore;        // Actual final count (record byte 6)
+    int theoreticalScore;  // Perfect play from theoreticalDepth empties (byte 7)
+    int theoreticalDepth;  // Header byte 14
+};
+
+/**
+ * @brief Converts a WThor move byte ((row+1)*10 + (col+1)) to a square
+ *
+ * @param wthorMove WThor encoded move
+ * @return Move_t (0-63), or MOVE_NONE if invalid (0 ends the game)
+ */
+Move_t decodeWThorMove(uint8_t wthorMove);
+
+/**
+ * @brief Reads every game of a .wtb file
+ *
+ * Records without moves are skipped; scores are passed through unchecked.
+ *
+ * @param filename Path to .wtb file
+ * @param games Receives the games (appended)
+ * @return Number of games read, 0 if the file could not be opened
+ */
+int readWThorFile(const std::string& filename, std::vector<WThorGame>& games);
+
+#endif  // WTHOR_DATABASE_H
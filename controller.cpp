@@ -11,25 +11,28 @@
  */
 
 #include <algorithm>
-#include <thread>
-#include <atomic>
-#include <mutex>
 #include <iostream>
 #include <memory>
 
 #include "raylib.h"
 #include "ai/ai_factory.h"
+#include "ai/ai_worker.h"
 #include "view/view.h"
 #include "view/view_constants.h"
 #include "controller.h"
 
-static std::thread aiThread;
-static std::atomic<bool> aiThreadRunning(false);
-static std::mutex aiMutex;
-
 // Current AI instance
 static std::unique_ptr<AIInterface> currentAI;
 
+// Long-lived engine thread; jobs in, results polled every frame
+static std::unique_ptr<AIWorker> aiWorker;
+static uint64_t pendingSearchJob = 0;  // 0 = no search whose result we want
+static uint64_t pendingPonderJob = 0;  // 0 = not pondering
+
+// Latest search snapshot read from the AI (drawn every frame)
+static SearchProgress aiSearchProgress;
+static bool hasSearchProgress = false;
+
 // Menu / app state
 enum GameState {
     STATE_MAIN_MENU,
@@ -53,82 +56,107 @@ static int scheduledDifficulty = -1;
 static int pendingNodeLimit = -1;
 
 // ---------------------------------------------------------------------------
-// AI thread worker
+// AI worker interaction
 // ---------------------------------------------------------------------------
 
 /**
- * @brief AI worker function running in separate thread
- * @param modelPtr Pointer to game model for analysis
+ * @brief True while the worker has a queued or running job
+ *
+ * While busy, the current AI instance must not be replaced or reconfigured.
  */
-void aiWorkerFunction(GameModel* modelPtr) {
-    // Create thread-safe copy of model
-    GameModel localModel;
-    {
-        std::lock_guard<std::mutex> lock(aiMutex);
-        localModel = *modelPtr;
-    }
+static bool isAIBusy() {
+    return aiWorker && aiWorker->isBusy();
+}
 
-    // Verify AI instance exists
-    if (!currentAI) {
-        std::cerr << "[AI Thread] ERROR: No AI instance!" << std::endl;
-        std::lock_guard<std::mutex> lock(aiMutex);
-        modelPtr->aiThinking = false;
-        aiThreadRunning = false;
+/**
+ * @brief Lets the AI search on the human's time (after its own move)
+ */
+static void startAIPondering(GameModel& model) {
+    if (!currentAI || !aiWorker) {
         return;
     }
 
-    std::cout << "[AI Thread] Using: " << currentAI->getName() << std::endl;
-
-    // Polymorphic AI call (may be expensive / blocking)
-    Move_t bestMove = currentAI->getBestMove(localModel);
-
-    std::cout << "[AI Thread] Found move: " << (int)bestMove << std::endl;
+    pendingPonderJob = aiWorker->submit(AI_JOB_PONDER, currentAI.get(), model);
+}
 
-    // Store result with thread safety
-    {
-        std::lock_guard<std::mutex> lock(aiMutex);
-        modelPtr->aiMove = bestMove;
-        modelPtr->aiThinking = false;
+/**
+ * @brief Ends pondering as soon as the human has moved
+ * @param wait Also wait for the worker (needed before touching the AI instance)
+ */
+static void stopAIPondering(bool wait) {
+    if (pendingPonderJob == 0) {
+        return;
     }
 
-    aiThreadRunning = false;
+    // Pondering is the only job while the human is to move, so this
+    // cannot cancel a real search
+    aiWorker->cancelAll();
+    if (wait) {
+        aiWorker->waitIdle();
+    }
+    pendingPonderJob = 0;
 }
 
 /**
- * @brief Starts AI analysis in background thread
+ * @brief Starts AI analysis on the worker thread
  */
 void startAIThinking(GameModel& model) {
-    if (!currentAI) {
+    if (!currentAI || !aiWorker) {
         std::cerr << "[Main] ERROR: No AI initialized! Call initializeAI() first." << std::endl;
         return;
     }
 
-    // Ensure previously launched thread has finished
-    if (aiThread.joinable()) {
-        aiThread.join();
-    }
+    stopAIPondering(false);
 
     model.aiThinking = true;
     model.aiMove = MOVE_NONE;
-    aiThreadRunning = true;
-
-    // Launch worker
-    aiThread = std::thread(aiWorkerFunction, &model);
 
+    // Runs after the ponder job (if still unwinding), whose TT entries it
+    // reuses. The job carries its own copy of the model, so no locking is needed
+    pendingSearchJob = aiWorker->submit(AI_JOB_SEARCH, currentAI.get(), model);
 }
 
-static void cancelAIIfRunning(GameModel& model) {
-    if (aiThreadRunning) {
-        {
-            std::lock_guard<std::mutex> lock(aiMutex);
+/**
+ * @brief Drains finished results, keeping only the one we are waiting for
+ */
+static void pollAIResults(GameModel& model) {
+    if (!aiWorker) {
+        return;
+    }
+
+    AIResult result;
+    while (aiWorker->pollResult(result)) {
+        if (result.type == AI_JOB_SEARCH && result.jobId == pendingSearchJob) {
+            model.aiMove = result.move;
             model.aiThinking = false;
-            model.aiMove = MOVE_NONE;
-        }
-        aiThreadRunning = false;
-        if (aiThread.joinable()) {
-            aiThread.join();
+            pendingSearchJob = 0;
+
+            // The worker is idle until the next job, so the stats are stable
+            SearchStats stats;
+            currentAI->getSearchStats(stats);
+            if (stats.nodes > 0) {
+                std::cout << "[Main] " << currentAI->getName() << ": " << stats.nodes << " nodes, "
+                    << (uint64_t)stats.nodesPerSecond << " nps, depth " << stats.depth << "/"
+                    << stats.selectiveDepth << ", " << stats.elapsed << "s, TT hits "
+                    << (stats.ttHitRate * 100.0) << "%, cutoffs " << stats.cutoffs << ", evals "
+                    << stats.evalCalls << std::endl;
+            }
         }
+        // Results of cancelled jobs are simply dropped
+    }
+}
+
+static void cancelAIIfRunning(GameModel& model) {
+    if (isAIBusy()) {
+        // Ask the search to unwind; waiting is then a matter of milliseconds
+        aiWorker->cancelAll();
+        aiWorker->waitIdle();
     }
+
+    pendingSearchJob = 0;
+    pendingPonderJob = 0;
+    model.aiThinking = false;
+    model.aiMove = MOVE_NONE;
 }
 
 /**
@@ -145,7 +173,7 @@ void applyNodeLimitToCurrentAI() {
 }
 
 static void applyScheduledDifficultyIfAny() {
-    // Called from main thread when it's safe to change AI (aiThreadStopped).
+    // Called from main thread when it's safe to change AI (worker idle).
     if (scheduledDifficulty != -1) {
         AIDifficulty pd = static_cast<AIDifficulty>(scheduledDifficulty);
         scheduledDifficulty = -1;
@@ -158,38 +186,30 @@ static void applyScheduledDifficultyIfAny() {
  * @return true if AI move was applied
  */
 bool checkAndApplyAIMove(GameModel& model) {
-    bool isThinking;
-    Move_t move;
+    pollAIResults(model);
 
-    {
-        std::lock_guard<std::mutex> lock(aiMutex);
-        isThinking = model.aiThinking;
-        move = model.aiMove;
-    }
+    Move_t move = model.aiMove;
 
     // If AI finished and produced a move (not MOVE_NONE), apply it
-    if (!isThinking && move != MOVE_NONE) {
+    if (!model.aiThinking && move != MOVE_NONE) {
         bool moveApplied = playMove(model, move);
 
         // Clear stored move
-        {
-            std::lock_guard<std::mutex> lock(aiMutex);
-            model.aiMove = MOVE_NONE;
-        }
+        model.aiMove = MOVE_NONE;
 
-        // Ensure thread joined
-        if (aiThread.joinable()) {
-            aiThread.join();
+        // Apply any scheduled difficulty change once the worker is idle
+        if (!isAIBusy()) {
+            applyScheduledDifficultyIfAny();
         }
 
-        // After thread has stopped, apply any scheduled difficulty change
-        // (safe because aiThread has been joined and aiThreadRunning should be false)
-        applyScheduledDifficultyIfAny();
-
         if (moveApplied) {
             std::cout << "[Main] GameOver: " << model.gameOver
                 << ", Current player: " << (model.currentPlayer == PLAYER_BLACK ? "BLACK" : "WHITE")
                 << ", ShowPass: " << model.playedPass << std::endl;
+
+            if (!model.gameOver && model.currentPlayer == model.humanPlayer) {
+                startAIPondering(model);
+            }
         }
         else {
             std::cout << "[Main] WARNING: Move was rejected by playMove!" << std::endl;
@@ -209,7 +229,12 @@ void initializeAI(AIDifficulty difficulty) {
     std::cout << "[Controller] Initializing AI: "
         << AIFactory::getDifficultyName(difficulty) << std::endl;
 
+    if (!aiWorker) {
+        aiWorker = std::make_unique<AIWorker>();
+    }
+
     currentAI = AIFactory::createAI(difficulty);
+    hasSearchProgress = false;
 
     if (currentAI) {
         std::cout << "[Controller] AI ready: " << currentAI->getName() << std::endl;
@@ -222,18 +247,15 @@ void initializeAI(AIDifficulty difficulty) {
 }
 
 void changeAIDifficulty(AIDifficulty difficulty) {
+    stopAIPondering(true);
+
     // If the AI is currently thinking, schedule the change instead of forcing it.
-    if (aiThreadRunning) {
+    if (isAIBusy()) {
         std::cerr << "[Controller] AI is thinking, scheduling difficulty change after finish.\n";
         scheduledDifficulty = static_cast<int>(difficulty);
         return;
     }
 
-    // Ensure thread (if any) is joined before replacing AI instance
-    if (aiThread.joinable()) {
-        aiThread.join();
-    }
-
     currentDifficulty = difficulty;
     initializeAI(difficulty);
 
@@ -353,9 +375,12 @@ void handleSettingsOverlay(GameModel& model) {
         }
         // Confirm selection: apply immediately if safe, otherwise schedule
         else if (isMousePointerOverConfirmAISettingsButton()) {
+            // Pondering is speculative: drop it rather than defer the change
+            stopAIPondering(true);
+
             if (settingsPendingSelection != -1) {
                 AIDifficulty desired = static_cast<AIDifficulty>(settingsPendingSelection);
-                if (aiThreadRunning) {
+                if (isAIBusy()) {
                     // schedule for when AI finishes
                     scheduledDifficulty = static_cast<int>(desired);
                 }
@@ -367,7 +392,7 @@ void handleSettingsOverlay(GameModel& model) {
             if (pendingNodeLimit != -1 && pendingNodeLimit != currentNodeLimit) {
                 currentNodeLimit = pendingNodeLimit;
 
-                if (!aiThreadRunning && currentAI) {
+                if (!isAIBusy() && currentAI) {
                     applyNodeLimitToCurrentAI();
                 }
             }
@@ -410,11 +435,11 @@ void handleSettingsOverlay(GameModel& model) {
     }
 
     // If AI is not thinking and there is a scheduled difficulty, apply it now.
-    if (!aiThreadRunning && scheduledDifficulty != -1) {
+    if (!isAIBusy() && scheduledDifficulty != -1) {
         applyScheduledDifficultyIfAny();
     }
 
-    if (!aiThreadRunning && currentAI && currentNodeLimit != currentAI->getNodeLimit()) {
+    if (!isAIBusy() && currentAI && (uint64_t)currentNodeLimit != currentAI->getNodeLimit()) {
         applyNodeLimitToCurrentAI();
     }
 }
@@ -498,6 +523,7 @@ void handleGameplay(GameModel& model) {
 
                 auto it = std::find(validMoves.begin(), validMoves.end(), move);
                 if (it != validMoves.end()) {
+                    stopAIPondering(false);
                     playMove(model, move);
                 }
             }
@@ -537,9 +563,8 @@ void handleGameplay(GameModel& model) {
  */
 bool updateView(GameModel& model) {
     if (WindowShouldClose()) {
-        if (aiThread.joinable()) {
-            aiThread.join();
-        }
+        // Stops any running search and joins the worker thread
+        aiWorker.reset();
         return false;
     }
 
@@ -575,7 +600,13 @@ bool updateView(GameModel& model) {
             ? pendingNodeLimit
             : currentNodeLimit;
 
-        drawView(model, showSettingsOverlay, displayedDifficulty, displayNodeLimit, aiEnabled);
+        // Never blocks: returns the newest snapshot the search published
+        if (currentAI && currentAI->readSearchProgress(aiSearchProgress)) {
+            hasSearchProgress = true;
+        }
+
+        drawView(model, showSettingsOverlay, displayedDifficulty, displayNodeLimit, aiEnabled,
+            hasSearchProgress ? &aiSearchProgress : nullptr);
         break;
     }
     }
@@ -143,6 +143,24 @@ namespace {
         return shiftFunc(candidates) & empty;
     }
 
+    /**
+     * @brief Squares whose line along one axis holds an empty square.
+     *
+     * Floods the empty squares in both directions of the axis; the
+     * complement is the set of squares on completely filled lines.
+     */
+    uint64_t getOpenLines(uint64_t empty, uint64_t(*forward)(uint64_t), uint64_t(*backward)(uint64_t)) {
+        uint64_t ahead = empty;
+        uint64_t behind = empty;
+
+        for (int step = 0; step < 7; ++step) {
+            ahead |= forward(ahead);
+            behind |= backward(behind);
+        }
+
+        return ahead | behind;
+    }
+
 }
 
 // ---------------------------------------------------------------------------
@@ -183,6 +201,52 @@ uint64_t calculateFlips(uint64_t player, uint64_t opponent, Move_t move) {
     return allFlips;
 }
 
+uint64_t getStableDiscs(uint64_t player, uint64_t opponent) {
+    uint64_t occupied = player | opponent;
+
+    // Full rows and columns: AND each line down to its first square,
+    // then copy the result back across the line
+    uint64_t rows = occupied & (occupied >> 1);
+    rows &= rows >> 2;
+    rows &= rows >> 4;
+    uint64_t fullRows = (rows & FILE_A) * 0xFF;
+
+    uint64_t columns = occupied & (occupied >> 8);
+    columns &= columns >> 16;
+    columns &= columns >> 32;
+    uint64_t fullColumns = (columns & RANK_1) * FILE_A;
+
+    uint64_t fullDiagonals = ~getOpenLines(~occupied, shiftSE, shiftNW);   // A1-H8 direction
+    uint64_t fullAntiDiagonals = ~getOpenLines(~occupied, shiftSW, shiftNE);
+
+    // A disc cannot be flipped along an axis if the line is full, or if a
+    // neighbour on that axis is the board edge or a stable disc of its own
+    // colour. Growing from no stable discs reaches the smallest set that
+    // satisfies this on all four axes, so every disc in it is truly stable.
+    uint64_t stable = 0ULL;
+    for (;;) {
+        uint64_t horizontal = fullRows | FILE_A | FILE_H | shiftE(stable) | shiftW(stable);
+        uint64_t vertical = fullColumns | RANK_1 | RANK_8 | shiftS(stable) | shiftN(stable);
+        uint64_t diagonal = fullDiagonals | FILE_A | FILE_H | RANK_1 | RANK_8 |
+            shiftSE(stable) | shiftNW(stable);
+        uint64_t antiDiagonal = fullAntiDiagonals | FILE_A | FILE_H | RANK_1 | RANK_8 |
+            shiftSW(stable) | shiftNE(stable);
+
+        uint64_t grown = player & horizontal & vertical & diagonal & antiDiagonal;
+        if (grown == stable) {
+            return stable;
+        }
+        stable = grown;
+    }
+}
+
+unsigned getQuadrantParity(uint64_t empty) {
+    return (countBits(empty & QUADRANT_A1) & 1) |
+        ((countBits(empty & QUADRANT_H1) & 1) << 1) |
+        ((countBits(empty & QUADRANT_A8) & 1) << 2) |
+        ((countBits(empty & QUADRANT_H8) & 1) << 3);
+}
+
 int countBits(uint64_t bitmap) {
 #if defined(_MSC_VER)
     return static_cast<int>(__popcnt64(bitmap));
@@ -208,6 +208,25 @@ bool playMove(GameModel& model, Move_t move);
 uint64_t getValidMovesBitmap(uint64_t player, uint64_t opponent);
 uint64_t calculateFlips(uint64_t player, uint64_t opponent, Move_t move);
 
+/**
+ * @brief Discs of player that can never be flipped again.
+ *
+ * Combines lines already full in each of the 4 axes with propagation from
+ * the edges: a disc is stable when, on every axis, its line is full or one
+ * neighbour is the edge or another stable disc of the same colour. Every
+ * reported disc is stable; a few stable discs may be missed.
+ */
+uint64_t getStableDiscs(uint64_t player, uint64_t opponent);
+
+/**
+ * @brief Parity of the empty squares in each board quadrant.
+ *
+ * Bit q is set when quadrant q (see getQuadrant()) holds an odd number of
+ * empty squares. Every move toggles exactly the bit of its own quadrant,
+ * so searches can keep the mask up to date with one XOR per move.
+ */
+unsigned getQuadrantParity(uint64_t empty);
+
 int countBits(uint64_t bitmap);
 Move_t bitScanForward(uint64_t bb);
 
@@ -279,6 +298,13 @@ inline bool boardsEqual(const Board_t& a, const Board_t& b) {
     return (a.black == b.black) && (a.white == b.white);
 }
 
+/**
+ * @brief Quadrant of a square: 0 = A1-D4, 1 = E1-H4, 2 = A5-D8, 3 = E5-H8
+ */
+inline int getQuadrant(Move_t move) {
+    return ((move >> 4) & 2) | ((move >> 2) & 1);
+}
+
 // ---------------------------------------------------------------------------
 // Bitboard masks
 // ---------------------------------------------------------------------------
@@ -290,6 +316,11 @@ inline bool boardsEqual(const Board_t& a, const Board_t& b) {
 #define INNER      0x007E7E7E7E7E7E00ULL
 #define CENTER_4   0x0000001818000000ULL
 
+#define QUADRANT_A1 0x000000000F0F0F0FULL
+#define QUADRANT_H1 0x00000000F0F0F0F0ULL
+#define QUADRANT_A8 0x0F0F0F0F00000000ULL
+#define QUADRANT_H8 0xF0F0F0F000000000ULL
+
 inline int countRegion(const Board_t& board, PlayerColor_t player, uint64_t mask) {
     return countBits(getPlayerBitboard(board, player) & mask);
 }
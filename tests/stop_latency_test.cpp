@@ -0,0 +1,169 @@
+/**
+ * @brief Measures how fast a running search returns after stop()
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ *
+ * Each searching AI first runs one search to completion from a fixed
+ * position to measure how long it takes. A fresh instance then repeats it
+ * on a worker thread and gets stop() halfway through. The test fails unless
+ * the stopped search searched fewer nodes than the full one (so the stop
+ * landed mid-search), returned a move, and did so within
+ * STOP_LATENCY_LIMIT_MS. Run from the repository root so AIExtreme finds
+ * its databases.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+
+#include "../ai/ai_factory.h"
+#include "../model.h"
+
+#define STOP_LATENCY_LIMIT_MS 20.0     // "A few milliseconds", with sanitizer headroom
+#define TEST_EMPTY_SQUARES 36          // Midgame: past the book, wide trees, far from a solve
+#define TEST_SEED 2024
+#define TEST_EXTREME_NODE_LIMIT 1000000  // Extreme has no fixed depth: end its full search here
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Plays random moves from the start position down to emptyCount
+ */
+static void setupPosition(GameModel& model, int emptyCount) {
+    std::mt19937 rng(TEST_SEED);
+
+    Board_t board;
+    board.black = (1ULL << 28) | (1ULL << 35);
+    board.white = (1ULL << 27) | (1ULL << 36);
+    PlayerColor_t player = PLAYER_BLACK;
+
+    while (getEmptyCount(board) > emptyCount) {
+        MoveList moves;
+        getValidMovesAI(board, player, moves);
+        if (moves.empty()) {
+            player = getOpponent(player);
+            continue;
+        }
+        makeMove(board, player, moves[rng() % moves.size()]);
+    }
+    if (!hasValidMoves(board, player)) {
+        player = getOpponent(player);
+    }
+
+    model = GameModel{};
+    model.board = board;
+    model.currentPlayer = player;
+    model.humanPlayer = getOpponent(player);
+}
+
+/**
+ * @brief Outcome of one search
+ */
+struct SearchRun {
+    Move_t move;
+    uint64_t nodes;
+    double searchMs;       // getBestMove() call to return
+    double stopLatencyMs;  // stop() call to return, negative if never stopped
+};
+
+/**
+ * @brief Runs getBestMove() of a new AI on a worker thread
+ * @param stopAfterMs Search time before stop() is called (negative = never)
+ */
+static SearchRun runSearch(AIDifficulty difficulty,
+    const GameModel& position,
+    uint64_t nodeLimit,
+    double stopAfterMs) {
+    std::unique_ptr<AIInterface> ai = AIFactory::createAI(difficulty);
+    ai->setNodeLimit(nodeLimit);
+    ai->setTimeLimits(60.0, 60.0);
+
+    GameModel model = position;
+    SearchRun run = { MOVE_NONE, 0, 0.0, -1.0 };
+    Clock::time_point started;
+    Clock::time_point returned;
+    std::atomic<bool> running{ false };
+
+    std::thread worker([&] {
+        started = Clock::now();
+        running.store(true, std::memory_order_release);
+        run.move = ai->getBestMove(model);
+        returned = Clock::now();
+    });
+
+    if (stopAfterMs >= 0.0) {
+        // Spin rather than sleep: sleeps overshoot by more than a short search
+        while (!running.load(std::memory_order_acquire)) {
+        }
+        while (std::chrono::duration<double, std::milli>(Clock::now() - started).count() <
+               stopAfterMs) {
+        }
+
+        Clock::time_point stopped = Clock::now();
+        ai->stop();
+        worker.join();
+        run.stopLatencyMs = std::chrono::duration<double, std::milli>(returned - stopped).count();
+    }
+    else {
+        worker.join();
+    }
+
+    SearchStats stats;
+    ai->getSearchStats(stats);
+    run.nodes = stats.nodes;
+    run.searchMs = std::chrono::duration<double, std::milli>(returned - started).count();
+    return run;
+}
+
+/**
+ * @brief Stops a search halfway through and checks how fast it returns
+ * @return False if the stop missed the search, or it returned too late or
+ *         without a move
+ */
+static bool testStopLatency(AIDifficulty difficulty, const GameModel& position, uint64_t nodeLimit) {
+    const char* name = AIFactory::getDifficultyName(difficulty);
+
+    SearchRun full = runSearch(difficulty, position, nodeLimit, -1.0);
+    SearchRun stopped = runSearch(difficulty, position, nodeLimit, full.searchMs / 2.0);
+
+    bool midSearch = stopped.nodes < full.nodes;
+    bool passed = midSearch && stopped.stopLatencyMs >= 0.0 &&
+                  stopped.stopLatencyMs <= STOP_LATENCY_LIMIT_MS && stopped.move != MOVE_NONE;
+
+    std::cout << name << ": full search " << full.searchMs << " ms, " << full.nodes
+              << " nodes; stopped after " << stopped.nodes << " nodes, returned "
+              << stopped.stopLatencyMs << " ms after stop() with move ";
+    if (stopped.move == MOVE_NONE) {
+        std::cout << "none";
+    }
+    else {
+        std::cout << (char)('A' + getMoveX(stopped.move)) << (getMoveY(stopped.move) + 1);
+    }
+    if (!midSearch) {
+        std::cout << " (search finished before stop())";
+    }
+    std::cout << (passed ? " [ok]" : " [FAILED]") << std::endl;
+    return passed;
+}
+
+int main() {
+    GameModel position;
+    setupPosition(position, TEST_EMPTY_SQUARES);
+
+    bool passed = true;
+    passed &= testStopLatency(AI_NORMAL, position, UINT64_MAX);
+    passed &= testStopLatency(AI_HARD, position, UINT64_MAX);
+    passed &= testStopLatency(AI_EXTREME, position, TEST_EXTREME_NODE_LIMIT);
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,798 @@
+/**
+ * @brief Offline trainer for the pattern evaluation weights
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ *
+ * Replays every game of the WTH databases, extracts the pattern indices of
+ * each position and fits one weight table per game phase against the final
+ * disc differential. The result is written where AIExtreme looks for it.
+ * With --nnue it trains the neural evaluator on the same positions instead.
+ *
+ * Usage: trainer [--nnue] [databases dir] [output file] [epochs] [threads]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../ai/nnue_eval.h"
+#include "../ai/pattern_eval.h"
+#include "../ai/wthor_database.h"
+#include "../model.h"
+
+namespace fs = std::filesystem;
+
+// ============================================================================
+// Trainer Configuration
+// ============================================================================
+
+#define TRAINER_EPOCHS 40            // Full passes over each phase's samples
+#define TRAINER_LEARNING_RATE 1.0f   // Fraction of the mean residual corrected per pass
+#define TRAINER_MIN_OCCURRENCES 32   // Rarer indices are damped towards zero
+#define TRAINER_HOLDOUT_EVERY 10     // Every Nth game is kept for validation
+
+/**
+ * @brief Positions of one phase, stored as flat index rows
+ */
+struct SampleSet {
+    std::vector<uint16_t> indices;  // getInstanceCount() entries per sample
+    std::vector<float> targets;     // Final margin, evaluation units, black's view
+    std::vector<uint8_t> holdout;   // 1 if the sample comes from a validation game
+
+    size_t size() const {
+        return targets.size();
+    }
+};
+
+// ============================================================================
+// Database Loading
+// ============================================================================
+
+/**
+ * @brief Reads every game of a .wtb file whose scores are valid disc counts
+ */
+static int loadWTBFile(const fs::path& filename, std::vector<WThorGame>& games) {
+    std::vector<WThorGame> fileGames;
+    readWThorFile(filename.string(), fileGames);
+
+    int gamesLoaded = 0;
+    for (WThorGame& game : fileGames) {
+        if (game.blackScore <= 64 && game.theoreticalScore <= 64) {
+            games.push_back(std::move(game));
+            gamesLoaded++;
+        }
+    }
+
+    return gamesLoaded;
+}
+
+// ============================================================================
+// Feature Extraction
+// ============================================================================
+
+/**
+ * @brief Replays a game, calling visit(board, emptyCount, margin) after
+ * every move that leaves empty squares
+ *
+ * Passes are not recorded in WThor games, so the side to move is switched
+ * whenever the expected player has no legal move.
+ *
+ * The margin (black's final disc lead; empty squares count for the winner)
+ * is an approximate label. WThor's theoretical score is the perfect-play
+ * result from the game's position at the theoretical depth onward, exact
+ * only at that position; earlier positions take it as an estimate of
+ * their own value. Positions after it take the actual result, which
+ * matches perfect play only if the players did not err.
+ *
+ * @return False if the game contains an illegal move
+ */
+template <typename Visitor>
+static bool replayGame(const WThorGame& game, Visitor visit) {
+    Board_t board;
+    board.black = (1ULL << 28) | (1ULL << 35);
+    board.white = (1ULL << 27) | (1ULL << 36);
+    PlayerColor_t player = PLAYER_BLACK;
+
+    int actualMargin = 2 * game.blackScore - 64;
+    int theoreticalMargin = 2 * game.theoreticalScore - 64;
+
+    for (Move_t move : game.moves) {
+        if (!isMoveValid(board, player, move)) {
+            player = getOpponent(player);
+            if (!isMoveValid(board, player, move)) {
+                return false;
+            }
+        }
+
+        makeMove(board, player, move);
+
+        int emptyCount = getEmptyCount(board);
+        if (emptyCount > 0) {
+            visit(board, emptyCount,
+                (emptyCount >= game.theoreticalDepth) ? theoreticalMargin : actualMargin);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Replays games [begin, end) and keeps the positions of one phase
+ *
+ * Games containing an illegal move are dropped.
+ */
+static void extractPhase(const std::vector<WThorGame>& games,
+    size_t begin,
+    size_t end,
+    int phase,
+    SampleSet& samples) {
+    int instanceCount = PatternEvaluator::getInstanceCount();
+    PatternState state;
+
+    for (size_t g = begin; g < end; g++) {
+        uint8_t holdout = (g % TRAINER_HOLDOUT_EVERY) == 0;
+        SampleSet gameSamples;
+
+        bool valid = replayGame(games[g], [&](const Board_t& board, int emptyCount, int margin) {
+            if (PatternEvaluator::getPhase(emptyCount) != phase)
+                return;
+
+            PatternEvaluator::setBoard(state, board);
+            gameSamples.indices.insert(
+                gameSamples.indices.end(), state.index, state.index + instanceCount);
+            gameSamples.targets.push_back((float)(margin * PATTERN_SCORE_PER_DISC));
+            gameSamples.holdout.push_back(holdout);
+        });
+
+        if (valid) {
+            samples.indices.insert(
+                samples.indices.end(), gameSamples.indices.begin(), gameSamples.indices.end());
+            samples.targets.insert(
+                samples.targets.end(), gameSamples.targets.begin(), gameSamples.targets.end());
+            samples.holdout.insert(
+                samples.holdout.end(), gameSamples.holdout.begin(), gameSamples.holdout.end());
+        }
+    }
+}
+
+/**
+ * @brief Extracts one phase's samples, splitting the games across threads
+ */
+static void extractPhaseParallel(const std::vector<WThorGame>& games,
+    int phase,
+    int threadCount,
+    SampleSet& samples) {
+    std::vector<SampleSet> parts(threadCount);
+    std::vector<std::thread> threads;
+    size_t chunk = (games.size() + threadCount - 1) / threadCount;
+
+    for (int t = 0; t < threadCount; t++) {
+        size_t begin = std::min(games.size(), t * chunk);
+        size_t end = std::min(games.size(), begin + chunk);
+        threads.emplace_back(extractPhase, std::cref(games), begin, end, phase, std::ref(parts[t]));
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Concatenated in game order, so results do not depend on the thread count
+    for (const SampleSet& part : parts) {
+        samples.indices.insert(samples.indices.end(), part.indices.begin(), part.indices.end());
+        samples.targets.insert(samples.targets.end(), part.targets.begin(), part.targets.end());
+        samples.holdout.insert(samples.holdout.end(), part.holdout.begin(), part.holdout.end());
+    }
+}
+
+// ============================================================================
+// Fitting
+// ============================================================================
+
+/**
+ * @brief Per-thread accumulation of residuals for samples [begin, end)
+ */
+static void accumulateResiduals(const SampleSet& samples,
+    const std::vector<float>& weights,
+    size_t begin,
+    size_t end,
+    std::vector<float>& gradient,
+    double& trainError,
+    double& holdoutError) {
+    int instanceCount = PatternEvaluator::getInstanceCount();
+
+    for (size_t s = begin; s < end; s++) {
+        const uint16_t* index = &samples.indices[s * instanceCount];
+
+        float prediction = 0;
+        for (int i = 0; i < instanceCount; i++) {
+            prediction += weights[PatternEvaluator::getInstanceOffset(i) + index[i]];
+        }
+
+        float residual = samples.targets[s] - prediction;
+
+        if (samples.holdout[s]) {
+            holdoutError += (double)residual * residual;
+            continue;
+        }
+
+        trainError += (double)residual * residual;
+        for (int i = 0; i < instanceCount; i++) {
+            gradient[PatternEvaluator::getInstanceOffset(i) + index[i]] += residual;
+        }
+    }
+}
+
+/**
+ * @brief Least-squares fit of one phase by batch gradient descent
+ *
+ * Each weight moves by a fraction of the mean residual of the samples it
+ * appears in, which normalizes for how often each index occurs. Every
+ * instance of a sample moves at once, so the step is also divided by the
+ * instance count to keep the combined correction below the residual. Indices
+ * seen fewer than TRAINER_MIN_OCCURRENCES times are damped, acting as L2
+ * regularization for sparse configurations.
+ *
+ * @return Root-mean-square validation error, in discs
+ */
+static double fitPhase(const SampleSet& samples,
+    int epochs,
+    int threadCount,
+    std::vector<float>& weights) {
+    int instanceCount = PatternEvaluator::getInstanceCount();
+    size_t weightCount = weights.size();
+
+    // Occurrence count of every weight in the training samples
+    std::vector<float> occurrences(weightCount, 0);
+    size_t trainCount = 0;
+    for (size_t s = 0; s < samples.size(); s++) {
+        if (samples.holdout[s])
+            continue;
+        trainCount++;
+        for (int i = 0; i < instanceCount; i++) {
+            occurrences[PatternEvaluator::getInstanceOffset(i) +
+                        samples.indices[s * instanceCount + i]] += 1;
+        }
+    }
+    size_t holdoutCount = samples.size() - trainCount;
+
+    float step = TRAINER_LEARNING_RATE / instanceCount;
+
+    std::vector<std::vector<float>> gradients(threadCount, std::vector<float>(weightCount));
+    std::vector<double> trainErrors(threadCount);
+    std::vector<double> holdoutErrors(threadCount);
+    size_t chunk = (samples.size() + threadCount - 1) / threadCount;
+    double holdoutRms = 0;
+
+    for (int epoch = 0; epoch <= epochs; epoch++) {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; t++) {
+            std::fill(gradients[t].begin(), gradients[t].end(), 0.0f);
+            trainErrors[t] = 0;
+            holdoutErrors[t] = 0;
+
+            size_t begin = std::min(samples.size(), t * chunk);
+            size_t end = std::min(samples.size(), begin + chunk);
+            threads.emplace_back(accumulateResiduals, std::cref(samples), std::cref(weights),
+                begin, end, std::ref(gradients[t]), std::ref(trainErrors[t]),
+                std::ref(holdoutErrors[t]));
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        double trainError = 0;
+        double holdoutError = 0;
+        for (int t = 0; t < threadCount; t++) {
+            trainError += trainErrors[t];
+            holdoutError += holdoutErrors[t];
+        }
+        holdoutRms = holdoutCount ? std::sqrt(holdoutError / holdoutCount) : 0;
+
+        // The last pass only measures the final weights
+        if (epoch == epochs) {
+            std::cout << "    train rms " << std::fixed << std::setprecision(2)
+                      << (trainCount ? std::sqrt(trainError / trainCount) : 0) /
+                    PATTERN_SCORE_PER_DISC
+                      << " discs, validation rms " << holdoutRms / PATTERN_SCORE_PER_DISC
+                      << " discs" << std::endl;
+            break;
+        }
+
+        for (size_t w = 0; w < weightCount; w++) {
+            if (occurrences[w] == 0)
+                continue;
+
+            float gradient = 0;
+            for (int t = 0; t < threadCount; t++) {
+                gradient += gradients[t][w];
+            }
+
+            float count = std::max(occurrences[w], (float)TRAINER_MIN_OCCURRENCES);
+            weights[w] += step * gradient / count;
+        }
+    }
+
+    return holdoutRms / PATTERN_SCORE_PER_DISC;
+}
+
+/**
+ * @brief Fits all pattern phases and writes the weight file
+ */
+static bool trainPatterns(const std::vector<WThorGame>& games,
+    const fs::path& outputFile,
+    int epochs,
+    int threadCount) {
+    size_t weightsPerPhase = PatternEvaluator::getWeightsPerPhase();
+    std::cout << PatternEvaluator::getInstanceCount() << " pattern instances, "
+              << weightsPerPhase << " weights per phase, " << threadCount << " threads"
+              << std::endl;
+
+    std::vector<int16_t> output(PATTERN_PHASES * weightsPerPhase);
+    std::vector<float> weights(weightsPerPhase, 0.0f);
+
+    // Late phases first: each phase starts from the weights of the next one
+    // closer to the end, which speeds up convergence
+    for (int phase = 0; phase < PATTERN_PHASES; phase++) {
+        SampleSet samples;
+        extractPhaseParallel(games, phase, threadCount, samples);
+
+        std::cout << "Phase " << phase << " (" << phase * 4 + 1 << "-" << phase * 4 + 4
+                  << " empties): " << samples.size() << " positions" << std::endl;
+
+        fitPhase(samples, epochs, threadCount, weights);
+
+        for (size_t w = 0; w < weightsPerPhase; w++) {
+            float value = std::round(weights[w]);
+            value = std::clamp(value, (float)INT16_MIN, (float)INT16_MAX);
+            output[phase * weightsPerPhase + w] = (int16_t)value;
+        }
+    }
+
+    return PatternEvaluator::save(outputFile.string(), output);
+}
+
+// ============================================================================
+// Neural Network Training
+// ============================================================================
+
+#define NNUE_TRAINER_EPOCHS 12
+#define NNUE_TRAINER_BATCH 256
+#define NNUE_TRAINER_LEARNING_RATE 0.002f
+#define NNUE_TRAINER_DECAY 0.75f  // Learning rate factor per epoch
+
+/**
+ * @brief A position and its target, in units of NNUE_OUTPUT_DISCS
+ */
+struct BoardSample {
+    Board_t board;
+    float target;
+};
+
+/**
+ * @brief Number of floats in a NeuralNetwork (used as a flat parameter vector)
+ */
+static constexpr size_t NETWORK_PARAMETERS = sizeof(NeuralNetwork) / sizeof(float);
+
+/**
+ * @brief Replays games [begin, end) and keeps every position
+ */
+static void extractBoards(const std::vector<WThorGame>& games,
+    size_t begin,
+    size_t end,
+    std::vector<BoardSample>& train,
+    std::vector<BoardSample>& holdout) {
+    for (size_t g = begin; g < end; g++) {
+        std::vector<BoardSample> gameSamples;
+
+        bool valid = replayGame(games[g], [&](const Board_t& board, int, int margin) {
+            gameSamples.push_back({ board, (float)margin / NNUE_OUTPUT_DISCS });
+        });
+
+        if (valid) {
+            std::vector<BoardSample>& target = (g % TRAINER_HOLDOUT_EVERY) ? train : holdout;
+            target.insert(target.end(), gameSamples.begin(), gameSamples.end());
+        }
+    }
+}
+
+/**
+ * @brief Float forward pass and, if gradient is given, backpropagation
+ * @return Prediction error (output - target)
+ */
+static float trainSample(const NeuralNetwork& network,
+    const BoardSample& sample,
+    NeuralNetwork* gradient) {
+    int features[64];
+    int featureCount = 0;
+    for (uint64_t discs = sample.board.black; discs; discs &= discs - 1) {
+        features[featureCount++] = bitScanForward(discs);
+    }
+    for (uint64_t discs = sample.board.white; discs; discs &= discs - 1) {
+        features[featureCount++] = 64 + bitScanForward(discs);
+    }
+
+    float input1[NNUE_HIDDEN1];
+    float hidden1[NNUE_HIDDEN1];
+    for (int j = 0; j < NNUE_HIDDEN1; j++) {
+        input1[j] = network.inputBias[j];
+    }
+    for (int f = 0; f < featureCount; f++) {
+        const float* row = network.inputWeights[features[f]];
+        for (int j = 0; j < NNUE_HIDDEN1; j++) {
+            input1[j] += row[j];
+        }
+    }
+    for (int j = 0; j < NNUE_HIDDEN1; j++) {
+        hidden1[j] = std::clamp(input1[j], 0.0f, 1.0f);
+    }
+
+    int bucket = NeuralEvaluator::getBucket(64 - featureCount);
+
+    float input2[NNUE_HIDDEN2];
+    float hidden2[NNUE_HIDDEN2];
+    float output = network.outputBias[bucket];
+    for (int o = 0; o < NNUE_HIDDEN2; o++) {
+        const float* row = network.hiddenWeights[bucket][o];
+        float sum = network.hiddenBias[bucket][o];
+        for (int j = 0; j < NNUE_HIDDEN1; j++) {
+            sum += row[j] * hidden1[j];
+        }
+        input2[o] = sum;
+        hidden2[o] = std::clamp(sum, 0.0f, 1.0f);
+        output += network.outputWeights[bucket][o] * hidden2[o];
+    }
+
+    float error = output - sample.target;
+    if (!gradient) {
+        return error;
+    }
+
+    // Gradient of error^2 / 2
+    gradient->outputBias[bucket] += error;
+
+    float delta1[NNUE_HIDDEN1] = {};
+    for (int o = 0; o < NNUE_HIDDEN2; o++) {
+        gradient->outputWeights[bucket][o] += error * hidden2[o];
+
+        if (input2[o] <= 0.0f || input2[o] >= 1.0f)
+            continue;
+
+        float delta2 = error * network.outputWeights[bucket][o];
+        gradient->hiddenBias[bucket][o] += delta2;
+
+        const float* row = network.hiddenWeights[bucket][o];
+        float* rowGradient = gradient->hiddenWeights[bucket][o];
+        for (int j = 0; j < NNUE_HIDDEN1; j++) {
+            rowGradient[j] += delta2 * hidden1[j];
+            delta1[j] += delta2 * row[j];
+        }
+    }
+
+    for (int j = 0; j < NNUE_HIDDEN1; j++) {
+        if (input1[j] <= 0.0f || input1[j] >= 1.0f)
+            delta1[j] = 0.0f;
+        gradient->inputBias[j] += delta1[j];
+    }
+    for (int f = 0; f < featureCount; f++) {
+        float* rowGradient = gradient->inputWeights[features[f]];
+        for (int j = 0; j < NNUE_HIDDEN1; j++) {
+            rowGradient[j] += delta1[j];
+        }
+    }
+
+    return error;
+}
+
+/**
+ * @brief Per-thread gradient of samples order[begin, end)
+ */
+static void accumulateBatch(const NeuralNetwork& network,
+    const std::vector<BoardSample>& samples,
+    const std::vector<uint32_t>& order,
+    size_t begin,
+    size_t end,
+    NeuralNetwork& gradient,
+    double& squaredError) {
+    memset(&gradient, 0, sizeof(NeuralNetwork));
+    squaredError = 0;
+
+    for (size_t i = begin; i < end; i++) {
+        float error = trainSample(network, samples[order[i]], &gradient);
+        squaredError += (double)error * error;
+    }
+}
+
+/**
+ * @brief Keeps every weight inside the range its quantized type can hold
+ */
+static void clipNetwork(NeuralNetwork& network) {
+    for (auto& row : network.inputWeights) {
+        for (float& w : row) {
+            w = std::clamp(w, -NNUE_INPUT_WEIGHT_LIMIT, NNUE_INPUT_WEIGHT_LIMIT);
+        }
+    }
+    for (float& w : network.inputBias) {
+        w = std::clamp(w, -NNUE_INPUT_WEIGHT_LIMIT, NNUE_INPUT_WEIGHT_LIMIT);
+    }
+    for (auto& bucket : network.hiddenWeights) {
+        for (auto& row : bucket) {
+            for (float& w : row) {
+                w = std::clamp(w, -NNUE_HIDDEN_WEIGHT_LIMIT, NNUE_HIDDEN_WEIGHT_LIMIT);
+            }
+        }
+    }
+    for (auto& bucket : network.outputWeights) {
+        for (float& w : bucket) {
+            w = std::clamp(w, -NNUE_OUTPUT_WEIGHT_LIMIT, NNUE_OUTPUT_WEIGHT_LIMIT);
+        }
+    }
+}
+
+/**
+ * @brief Root-mean-square error of the float network, in discs
+ */
+static double measureNetwork(const NeuralNetwork& network,
+    const std::vector<BoardSample>& samples) {
+    double squaredError = 0;
+    for (const BoardSample& sample : samples) {
+        float error = trainSample(network, sample, nullptr);
+        squaredError += (double)error * error;
+    }
+    return samples.empty() ? 0 : std::sqrt(squaredError / samples.size()) * NNUE_OUTPUT_DISCS;
+}
+
+/**
+ * @brief Trains the network with minibatch Adam and writes the quantized file
+ *
+ * Positions from all phases are shuffled together; the bucketed layers let
+ * the network specialize by game stage. Each batch is split across the
+ * threads, whose gradients are summed before the update. After saving, the
+ * file is read back and the validation error of the integer inference is
+ * reported next to the float one.
+ */
+static bool trainNetwork(const std::vector<WThorGame>& games,
+    const fs::path& outputFile,
+    int epochs,
+    int threadCount) {
+    std::vector<std::vector<BoardSample>> trainParts(threadCount);
+    std::vector<std::vector<BoardSample>> holdoutParts(threadCount);
+    std::vector<std::thread> threads;
+    size_t chunk = (games.size() + threadCount - 1) / threadCount;
+    for (int t = 0; t < threadCount; t++) {
+        size_t begin = std::min(games.size(), t * chunk);
+        size_t end = std::min(games.size(), begin + chunk);
+        threads.emplace_back(extractBoards, std::cref(games), begin, end,
+            std::ref(trainParts[t]), std::ref(holdoutParts[t]));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::vector<BoardSample> train;
+    std::vector<BoardSample> holdout;
+    for (int t = 0; t < threadCount; t++) {
+        train.insert(train.end(), trainParts[t].begin(), trainParts[t].end());
+        holdout.insert(holdout.end(), holdoutParts[t].begin(), holdoutParts[t].end());
+        std::vector<BoardSample>().swap(trainParts[t]);
+        std::vector<BoardSample>().swap(holdoutParts[t]);
+    }
+
+    std::cout << "Network " << NNUE_INPUTS << "-" << NNUE_HIDDEN1 << "-" << NNUE_HIDDEN2
+              << "-1 x" << NNUE_BUCKETS << " buckets, " << NETWORK_PARAMETERS << " parameters, "
+              << train.size() << " training / " << holdout.size() << " validation positions, "
+              << threadCount << " threads" << std::endl;
+
+    std::mt19937 rng(20240101);
+    std::unique_ptr<NeuralNetwork> network = std::make_unique<NeuralNetwork>();
+    {
+        std::normal_distribution<float> inputInit(0.0f, 0.1f);
+        std::normal_distribution<float> hiddenInit(0.0f, 0.15f);
+        std::normal_distribution<float> outputInit(0.0f, 0.1f);
+
+        for (auto& row : network->inputWeights) {
+            for (float& w : row) {
+                w = inputInit(rng);
+            }
+        }
+        for (float& w : network->inputBias) {
+            w = 0.5f;
+        }
+        for (int b = 0; b < NNUE_BUCKETS; b++) {
+            for (int o = 0; o < NNUE_HIDDEN2; o++) {
+                for (float& w : network->hiddenWeights[b][o]) {
+                    w = hiddenInit(rng);
+                }
+                network->hiddenBias[b][o] = 0.5f;
+                network->outputWeights[b][o] = outputInit(rng);
+            }
+            network->outputBias[b] = 0.0f;
+        }
+    }
+
+    // Adam state, indexed like the flat parameter vector
+    std::vector<float> moment1(NETWORK_PARAMETERS, 0.0f);
+    std::vector<float> moment2(NETWORK_PARAMETERS, 0.0f);
+    const float beta1 = 0.9f;
+    const float beta2 = 0.999f;
+    float beta1Power = 1.0f;
+    float beta2Power = 1.0f;
+
+    std::vector<std::unique_ptr<NeuralNetwork>> gradients;
+    for (int t = 0; t < threadCount; t++) {
+        gradients.push_back(std::make_unique<NeuralNetwork>());
+    }
+    std::vector<double> squaredErrors(threadCount);
+
+    std::vector<uint32_t> order(train.size());
+    for (size_t i = 0; i < order.size(); i++) {
+        order[i] = (uint32_t)i;
+    }
+
+    float learningRate = NNUE_TRAINER_LEARNING_RATE;
+
+    for (int epoch = 0; epoch < epochs; epoch++) {
+        std::shuffle(order.begin(), order.end(), rng);
+        double trainError = 0;
+
+        for (size_t batch = 0; batch < order.size(); batch += NNUE_TRAINER_BATCH) {
+            size_t batchEnd = std::min(order.size(), batch + NNUE_TRAINER_BATCH);
+            size_t share = (batchEnd - batch + threadCount - 1) / threadCount;
+
+            if (threadCount == 1) {
+                accumulateBatch(*network, train, order, batch, batchEnd, *gradients[0],
+                    squaredErrors[0]);
+            } else {
+                threads.clear();
+                for (int t = 0; t < threadCount; t++) {
+                    size_t begin = std::min(batchEnd, batch + t * share);
+                    size_t end = std::min(batchEnd, begin + share);
+                    threads.emplace_back(accumulateBatch, std::cref(*network), std::cref(train),
+                        std::cref(order), begin, end, std::ref(*gradients[t]),
+                        std::ref(squaredErrors[t]));
+                }
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            float* parameters = reinterpret_cast<float*>(network.get());
+            float* gradient = reinterpret_cast<float*>(gradients[0].get());
+            for (int t = 1; t < threadCount; t++) {
+                const float* other = reinterpret_cast<const float*>(gradients[t].get());
+                for (size_t p = 0; p < NETWORK_PARAMETERS; p++) {
+                    gradient[p] += other[p];
+                }
+            }
+            for (int t = 0; t < threadCount; t++) {
+                trainError += squaredErrors[t];
+            }
+
+            beta1Power *= beta1;
+            beta2Power *= beta2;
+            float scale = 1.0f / (batchEnd - batch);
+            float stepSize = learningRate * std::sqrt(1.0f - beta2Power) / (1.0f - beta1Power);
+
+            for (size_t p = 0; p < NETWORK_PARAMETERS; p++) {
+                float g = gradient[p] * scale;
+                moment1[p] = beta1 * moment1[p] + (1.0f - beta1) * g;
+                moment2[p] = beta2 * moment2[p] + (1.0f - beta2) * g * g;
+                parameters[p] -= stepSize * moment1[p] / (std::sqrt(moment2[p]) + 1e-8f);
+            }
+
+            clipNetwork(*network);
+        }
+
+        std::cout << "Epoch " << epoch + 1 << ": train rms " << std::fixed << std::setprecision(2)
+                  << std::sqrt(trainError / train.size()) * NNUE_OUTPUT_DISCS
+                  << " discs, validation rms " << measureNetwork(*network, holdout)
+                  << " discs" << std::endl;
+
+        learningRate *= NNUE_TRAINER_DECAY;
+    }
+
+    if (!NeuralEvaluator::save(outputFile.string(), *network)) {
+        return false;
+    }
+
+    // Check the integer inference against the float network
+    std::unique_ptr<NeuralEvaluator> evaluator = std::make_unique<NeuralEvaluator>();
+    if (!evaluator->load(outputFile.string())) {
+        return false;
+    }
+
+    double squaredError = 0;
+    for (const BoardSample& sample : holdout) {
+        NeuralAccumulator accumulator;
+        evaluator->refresh(accumulator, sample.board);
+        double score = (double)evaluator->evaluate(accumulator, PLAYER_BLACK,
+                           getEmptyCount(sample.board)) / NNUE_SCORE_PER_DISC;
+        double error = score - sample.target * NNUE_OUTPUT_DISCS;
+        squaredError += error * error;
+    }
+    std::cout << "Quantized validation rms " << std::fixed << std::setprecision(2)
+              << (holdout.empty() ? 0 : std::sqrt(squaredError / holdout.size())) << " discs ("
+              << NeuralEvaluator::getInstructionSet() << ")" << std::endl;
+
+    return true;
+}
+
+// ============================================================================
+// Main
+// ============================================================================
+
+int main(int argc, char** argv) {
+    // --nnue selects the neural network; the positional arguments follow
+    bool neural = (argc > 1) && std::string(argv[1]) == "--nnue";
+    if (neural) {
+        argc--;
+        argv++;
+    }
+
+    fs::path databaseDir = (argc > 1) ? argv[1] : "databases";
+    fs::path outputFile = (argc > 2) ? fs::path(argv[2])
+                                     : databaseDir / (neural ? NNUE_WEIGHTS_FILE
+                                                             : PATTERN_WEIGHTS_FILE);
+    int epochs = (argc > 3) ? atoi(argv[3]) : (neural ? NNUE_TRAINER_EPOCHS : TRAINER_EPOCHS);
+    int threadCount = (argc > 4) ? atoi(argv[4]) : (int)std::thread::hardware_concurrency();
+    if (threadCount < 1)
+        threadCount = 1;
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Sorted so the holdout split is reproducible
+    std::vector<fs::path> files;
+    try {
+        for (const auto& entry : fs::directory_iterator(databaseDir)) {
+            if (entry.path().extension() == ".wtb") {
+                files.push_back(entry.path());
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading directory: " << e.what() << std::endl;
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<WThorGame> games;
+    for (const fs::path& file : files) {
+        loadWTBFile(file, games);
+    }
+
+    if (games.empty()) {
+        std::cerr << "No games found in " << databaseDir.string() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Training on " << games.size() << " games from " << files.size()
+              << " databases" << std::endl;
+
+    bool saved = neural ? trainNetwork(games, outputFile, epochs, threadCount)
+                        : trainPatterns(games, outputFile, epochs, threadCount);
+    if (!saved) {
+        std::cerr << "Failed to write " << outputFile.string() << std::endl;
+        return 1;
+    }
+
+    double elapsed =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "Weights written to " << outputFile.string() << " in " << std::fixed
+              << std::setprecision(1) << elapsed << "s" << std::endl;
+
+    return 0;
+}
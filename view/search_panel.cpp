@@ -0,0 +1,81 @@
+/**
+ * @brief AI search progress panel implementation
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#include "search_panel.h"
+#include "view_constants.h"
+#include "ui_components.h"
+#include "raylib.h"
+
+#include <cstdio>
+#include <string>
+
+ /**
+  * @brief Formats a count with a k/M suffix (e.g. 1.25M)
+  */
+static std::string formatCount(double value) {
+    char buffer[32];
+
+    if (value >= 1e6) {
+        snprintf(buffer, sizeof(buffer), "%.2fM", value / 1e6);
+    }
+    else if (value >= 1e3) {
+        snprintf(buffer, sizeof(buffer), "%.1fk", value / 1e3);
+    }
+    else {
+        snprintf(buffer, sizeof(buffer), "%.0f", value);
+    }
+
+    return buffer;
+}
+
+/**
+ * @brief Draws depth, score, nodes, speed and principal variation
+ * @param progress Latest snapshot published by the search thread
+ */
+void drawSearchPanel(const SearchProgress& progress) {
+    Color textColor = progress.active ? BLACK : DARKGRAY;
+    float y = SEARCH_PANEL_Y;
+
+    // Status and depth
+    std::string status = progress.pondering ? "Pondering" : (progress.active ? "Thinking" : "Last search");
+    status += "  -  depth " + std::to_string(progress.depth);
+    drawCenteredColoredText({ INFO_CENTERED_X, y }, SEARCH_PANEL_FONT_SIZE, status, textColor);
+    y += SEARCH_PANEL_LINE_HEIGHT;
+
+    // Score and nodes
+    char scoreText[64];
+    snprintf(scoreText, sizeof(scoreText), "Score %+d  -  %s nodes", progress.score,
+        formatCount((double)progress.nodes).c_str());
+    drawCenteredColoredText({ INFO_CENTERED_X, y }, SEARCH_PANEL_FONT_SIZE, scoreText, textColor);
+    y += SEARCH_PANEL_LINE_HEIGHT;
+
+    // Speed and time
+    double nps = (progress.elapsed > 0.0) ? progress.nodes / progress.elapsed : 0.0;
+    char speedText[64];
+    snprintf(speedText, sizeof(speedText), "%s nps  -  %.2f s", formatCount(nps).c_str(), progress.elapsed);
+    drawCenteredColoredText({ INFO_CENTERED_X, y }, SEARCH_PANEL_FONT_SIZE, speedText, textColor);
+    y += SEARCH_PANEL_LINE_HEIGHT;
+
+    // Principal variation
+    std::string pvText = "PV:";
+    for (int i = 0; i < progress.pvLength; i++) {
+        Move_t move = progress.pv[i];
+        pvText += ' ';
+        if (move == MOVE_PASS) {
+            pvText += "--";
+            continue;
+        }
+        pvText += (char)('A' + getMoveX(move));
+        pvText += (char)('1' + getMoveY(move));
+    }
+    drawCenteredColoredText({ INFO_CENTERED_X, y }, SEARCH_PANEL_FONT_SIZE, pvText, textColor);
+}
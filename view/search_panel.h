@@ -0,0 +1,21 @@
+/**
+ * @brief AI search progress panel
+ * @author Marc S. Ressl
+ * @modifiers:
+ *          Agustin Valenzuela,
+ *          Alex Petersen,
+ *          Dylan Frigerio,
+ *          Enzo Fernandez Rosas
+ *
+ * @copyright Copyright (c) 2023-2024
+ */
+
+#ifndef SEARCH_PANEL_H
+#define SEARCH_PANEL_H
+
+#include "../ai/search_progress.h"
+
+ // Panel rendering
+void drawSearchPanel(const SearchProgress& progress);
+
+#endif // SEARCH_PANEL_H
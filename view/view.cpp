@@ -17,6 +17,7 @@
 #include "game_overlay.h"
 #include "menu_system.h"
 #include "settings_overlay.h"
+#include "search_panel.h"
 #include "raylib.h"
 #include <cmath>
 
@@ -41,8 +42,10 @@ void freeView() {
  * @param showSettings Whether to show the settings overlay
  * @param aiDifficulty Current AI difficulty setting
  * @param nodeLimit Current node limit for AI
+ * @param searchProgress Latest AI search snapshot, or nullptr if none
  */
-void drawView(GameModel& model, bool showSettings, const std::string& aiDifficulty, int nodeLimit, bool aiActivate) {
+void drawView(GameModel& model, bool showSettings, const std::string& aiDifficulty, int nodeLimit, bool aiActivate,
+    const SearchProgress* searchProgress) {
     BeginDrawing();
     ClearBackground(BEIGE);
 
@@ -83,6 +86,11 @@ void drawView(GameModel& model, bool showSettings, const std::string& aiDifficul
             aiColorDifficulty = DARKPURPLE;
         }
         drawCenteredColoredText({ INFO_CENTERED_X, INFO_TITLE_Y + TITLE_FONT_SIZE * 0.8 }, SUBTITLE_FONT_SIZE, aiDifficulty, aiColorDifficulty);
+
+        // Game over buttons use the same area
+        if (searchProgress && !model.gameOver) {
+            drawSearchPanel(*searchProgress);
+        }
     }
 
     // Settings overlay (drawn last to be on top)
@@ -14,6 +14,7 @@
 #define VIEW_H
 
 #include "../model.h"
+#include "../ai/search_progress.h"
 #include <string>
 #include <raylib.h>
 
@@ -24,7 +25,8 @@
 void initView();
 void freeView();
 void drawView(GameModel& model, bool showSettings = false,
-    const std::string& aiDifficulty = "Normal", int nodeLimit = 500000, bool aiActivate = true);
+    const std::string& aiDifficulty = "Normal", int nodeLimit = 500000, bool aiActivate = true,
+    const SearchProgress* searchProgress = nullptr);
 Move_t getMoveOnMousePointer();
 
 // ============================================================================
@@ -56,6 +56,11 @@
 #define INFO_BLACK_SCORE_Y (WINDOW_HEIGHT * 3 / 4 - SUBTITLE_FONT_SIZE / 2)
 #define INFO_BLACK_TIME_Y (WINDOW_HEIGHT * 3 / 4 + SUBTITLE_FONT_SIZE / 2)
 
+// AI search progress panel (below the white timer)
+#define SEARCH_PANEL_FONT_SIZE 20
+#define SEARCH_PANEL_LINE_HEIGHT 26
+#define SEARCH_PANEL_Y (INFO_BLACK_TIME_Y + SUBTITLE_FONT_SIZE + SEARCH_PANEL_FONT_SIZE / 2)
+
 // Button configuration
 #define INFO_BUTTON_WIDTH 280
 #define INFO_BUTTON_HEIGHT 64